@@ -53,10 +53,11 @@ extern void SysTickIntHandler(void);
 
 //*****************************************************************************
 //
-// Reserve space for the system stack.
+// Reserve space for the system stack.  Sized for the deepest command call
+// chain plus one interrupt, see the RAM budget in setting.h.
 //
 //*****************************************************************************
-static unsigned long pulStack[64];
+static unsigned long pulStack[512];
 
 //*****************************************************************************
 //
@@ -0,0 +1,704 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  band.c
+ *
+ *    Description:  Banded off-screen renderer implementation file
+ *                  A full frame does not fit in SRAM, so the screen is
+ *                  rendered as horizontal strips. The scene is replayed for
+ *                  every strip, each primitive is clipped to the strip rows,
+ *                  and the strip is sent by uDMA while the next one is
+ *                  rendered. The whole frame is one address window, so the
+ *                  panel sees a single linear pixel stream.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 02:05:18 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "band.h"
+#include "tft.h"
+#include "fonts.h"
+#include "scratch.h"
+#include "setting.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* Number of strips (one rendered while the other is sent) */
+#define BAND_STRIP_COUNT    (2U)
+
+/* Pixels per strip */
+#define BAND_STRIP_PIXELS   (BAND_BUFFER_PIXELS / BAND_STRIP_COUNT)
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+/* Band being rendered */
+typedef struct
+{
+    /* Strip buffer of the band */
+    uint16_t *buffer;
+
+    /* First and last screen row of the band */
+    int32_t  y0;
+    int32_t  y1;
+
+    /* Screen size in the current orientation */
+    int32_t  width;
+    int32_t  height;
+
+    /* Strip used by the next band */
+    uint8_t  strip;
+} band_info_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+/* Strip buffers, in the scratch memory while a scene is rendered */
+static uint16_t     (*band_strip)[BAND_STRIP_PIXELS];
+
+static band_info_t  band_info;
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Fill pixels x0 to x1 (inclusive) of screen row y, clipped to the
+ *          band
+ * @param   x0      First x coordinate
+ * @param   x1      Last x coordinate
+ * @param   y       Screen row
+ * @param   color   Colour (16-bit)
+ */
+static void fill_span(int32_t x0, int32_t x1, int32_t y, uint16_t color)
+{
+    uint16_t *pixel;
+
+    if ((y < band_info.y0) || (y > band_info.y1))
+    {
+        return;
+    }
+
+    x0 = max(x0, 0);
+    x1 = min(x1, band_info.width - 1);
+
+    if (x0 > x1)
+    {
+        return;
+    }
+
+    pixel = &band_info.buffer[(y - band_info.y0) * band_info.width + x0];
+
+    for (; x0 <= x1; x0++)
+    {
+        *pixel++ = color;
+    }
+}
+
+/**
+ * @brief   Fill rows y0 to y1 (inclusive) of column x0 to x1, clipped to
+ *          the band
+ * @param   x0      First x coordinate
+ * @param   y0      First y coordinate
+ * @param   x1      Last x coordinate
+ * @param   y1      Last y coordinate
+ * @param   color   Colour (16-bit)
+ */
+static void fill_block(int32_t x0, int32_t y0,
+                       int32_t x1, int32_t y1,
+                       uint16_t color)
+{
+    y0 = max(y0, band_info.y0);
+    y1 = min(y1, band_info.y1);
+
+    for (; y0 <= y1; y0++)
+    {
+        fill_span(x0, x1, y0, color);
+    }
+}
+
+/**
+ * @brief   Block output of the span rasteriser
+ * @param   x0      First x coordinate
+ * @param   y0      First y coordinate
+ * @param   x1      Last x coordinate
+ * @param   y1      Last y coordinate
+ * @param   color   Colour (16-bit)
+ */
+static void raster_block(int16_t x0, int16_t y0,
+                         int16_t x1, int16_t y1,
+                         uint16_t color)
+{
+    fill_block(x0, y0, x1, y1, color);
+}
+
+/**
+ * @brief   Check whether rows y0 to y1 overlap the band
+ * @param   y0  First y coordinate
+ * @param   y1  Last y coordinate
+ * @return  True if any row is in the band
+ */
+static bool rows_in_band(int32_t y0, int32_t y1)
+{
+    return ((y1 >= band_info.y0) && (y0 <= band_info.y1));
+}
+
+/**
+ * @brief   Font glyph of an ASCII character ('?' if not printable)
+ * @param   ascii   ASCII Character
+ * @return  8 column bitmap, LSB is the top row
+ */
+static const uint8_t *glyph(uint8_t ascii)
+{
+    if ((ascii < 32) || (ascii > 127))
+    {
+        ascii = '?';
+    }
+
+    return font_map[ascii - 0x20];
+}
+
+/*-----------------------------------------------------------------------------
+ *  Scenes
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Same drawing as tft_test, rendered band by band
+ */
+static void test_scene(void)
+{
+    band_fill_area(0,0, 100, 100, BLUE);
+    band_fill_area(20,20, 80, 80, RED);
+    band_fill_rectangle(100, 100, 50, 50, GREEN);
+    band_draw_horizontal_line(0, 75, 240, WHITE);
+    band_draw_vertical_line(75, 0, 320, WHITE);
+    band_draw_line(0, 50, 240, 50, YELLOW);
+    band_draw_line(50, 0, 50, 320, CYAN);
+    band_draw_line(0, 0, 100, 100, GRAY1);
+    band_draw_rectangle(150,150,240,240,YELLOW);
+    band_draw_triangle(90,155,120,290,140,155, BLUE);
+    band_draw_circle(200, 50, 10, RED);
+    band_fill_circle(150, 50, 10, WHITE);
+    band_draw_char('j', 0, 120, 4, WHITE, RED);
+    band_draw_char('W', 30, 120, 6, WHITE, RED);
+    band_draw_string("abc", 0, 170, 3, BLACK, GREEN);
+    band_draw_number(-12345, 0, 200, 2, BLACK, GREEN);
+    band_draw_char_only('G', 200, 200, 3, WHITE);
+    band_draw_string_only("Tesla", 100, 170, 3, WHITE);
+}
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Render a scene to the whole screen band by band
+ *          The first band programs one window over the whole screen, every
+ *          following band continues the same memory write
+ * @param   scene       Scene drawing function
+ * @param   background  Colour of pixels not drawn by the scene
+ */
+void band_render(band_scene_t scene, uint16_t background)
+{
+    int32_t lines;
+    int32_t y;
+
+    ASSERT(scene != NULL);
+
+    band_strip = scratch_claim(SCRATCH_BAND,
+                               BAND_BUFFER_PIXELS * sizeof(uint16_t));
+
+    band_info.width = tft_get_width();
+    band_info.height = tft_get_height();
+
+    lines = BAND_STRIP_PIXELS / band_info.width;
+
+    ASSERT(lines > 0);
+
+    for (y = 0; y < band_info.height; y += lines)
+    {
+        /*
+         * The strip was sent two bands ago; starting the previous band
+         * waited for its transfer to complete
+         */
+        band_info.buffer = &band_strip[band_info.strip][0];
+        band_info.strip = (band_info.strip + 1) % BAND_STRIP_COUNT;
+
+        band_info.y0 = y;
+        band_info.y1 = min(y + lines, band_info.height) - 1;
+
+        band_clear(background);
+
+        scene();
+
+        tft_write_pixels(0, band_info.y0,
+                         band_info.width - 1, band_info.height - 1,
+                         band_info.buffer,
+                         (band_info.y1 - band_info.y0 + 1) * band_info.width);
+    }
+}
+
+/**
+ * @brief   Fill the current band with colour
+ * @param   color   Colour (16-bit)
+ */
+void band_clear(uint16_t color)
+{
+    fill_block(0, band_info.y0, band_info.width - 1, band_info.y1, color);
+}
+
+/**
+ * @brief   Set pixel to specific color
+ * @param   x       X coordinate
+ * @param   y       Y coordinate
+ * @param   color   Refer to COLOR macro
+ */
+void band_set_pixel(uint16_t x, uint16_t y, uint16_t color)
+{
+    fill_span(x, x, y, color);
+}
+
+/**
+ * @brief   Fill area (x0, y0) to (x1, y1) with colour
+ * @param   x0    Top left x coordinate
+ * @param   y0    Top left y coordinate
+ * @param   x1    Bottom right x coordinate
+ * @param   y1    Bottom right y coordinate
+ * @param   color Colour (16-bit)
+ */
+void band_fill_area(uint16_t x0, uint16_t y0,
+                    uint16_t x1, uint16_t y1,
+                    uint16_t color)
+{
+    fill_block(min(x0, x1), min(y0, y1), max(x0, x1), max(y0, y1), color);
+}
+
+/**
+ * @brief   Draw a coloured horizontal line starting at (x,y) with length
+ * @param   x         Starting x coordinate
+ * @param   y         Starting y coordinate
+ * @param   length    Length of the line
+ * @param   color     Colour (16-bit)
+ */
+void band_draw_horizontal_line(uint16_t x, uint16_t y,
+                               uint16_t length,
+                               uint16_t color)
+{
+    fill_span(x, (int32_t)x + length - 1, y, color);
+}
+
+/**
+ * @brief   Draw a coloured vertical line starting at (x,y) with length
+ * @param   x       Starting x coordinate
+ * @param   y       Starting y coordinate
+ * @param   length  Length of the line
+ * @param   color   Colour (16-bit)
+ */
+void band_draw_vertical_line(uint16_t x, uint16_t y,
+                             uint16_t length,
+                             uint16_t color)
+{
+    fill_block(x, y, x, (int32_t)y + length - 1, color);
+}
+
+/**
+ * @brief   Draw Line from (x0, y0) to (x1, y1) with color
+ * @param   x0      Starting point (x)
+ * @param   y0      Starting point (y)
+ * @param   x1      End Point (x)
+ * @param   y1      End Point (y)
+ * @param   color   Colour (16-bit)
+ */
+void band_draw_line(uint16_t x0, uint16_t y0,
+                    uint16_t x1, uint16_t y1,
+                    uint16_t color)
+{
+    int16_t x = x1-x0;
+    int16_t y = y1-y0;
+    int16_t dx = abs(x);
+    int16_t sx = x0<x1 ? 1 : -1;
+    int16_t dy = -abs(y);
+    int16_t sy = y0<y1 ? 1 : -1;
+    int16_t err = dx+dy;
+    int16_t e2;
+
+    if (!rows_in_band(min(y0, y1), max(y0, y1)))
+    {
+        return;
+    }
+
+    while(1)
+    {
+        fill_span(x0, x0, y0, color);
+        e2 = 2 * err;
+        if (e2 >= dy)
+        {
+            if(x0 == x1)
+                break;
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx)
+        {
+            if (y0 == y1)
+                break;
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+/**
+ * @brief   Draw rectangle with top left starting position (x,y) with length
+ *          and width filled with color (same area as tft_fill_rectangle)
+ * @param   x       Top left x coordinate
+ * @param   y       Top left y coordinate
+ * @param   length  Length of the rectangle
+ * @param   width   Width of the rectangle
+ * @param   color   Colour (16-bit)
+ */
+void band_fill_rectangle(uint16_t x, uint16_t y,
+                         uint16_t length, uint16_t width,
+                         uint16_t color)
+{
+    fill_block(x, y, (int32_t)x + length, (int32_t)y + length, color);
+}
+
+/**
+ * @brief   Draw circle with filled color with center at (xc, yc) with radius, r
+ * @param   xc      Center of circle (x)
+ * @param   yc      Center of circle (y)
+ * @param   r       Radius
+ * @param   color   Color (16-bit)
+ */
+void band_fill_circle(uint16_t xc, uint16_t yc,
+                      int16_t r,
+                      uint16_t color)
+{
+    if (!rows_in_band((int32_t)yc - r, (int32_t)yc + r))
+    {
+        return;
+    }
+
+    raster_fill_circle(raster_block, xc, yc, r, color);
+}
+
+/**
+* @brief    Draw filled Triangle based on Coordinate (x0, y0), (x1, y1) &
+*           (x2, y2)
+* @param    x0      first point (x-coordinate)
+* @param    y0      first point (y-coordinate)
+* @param    x1      second point (x-coordinate)
+* @param    y1      second point (y-coordinate)
+* @param    x2      third point (x-coordinate)
+* @param    y2      third point (y-coordinate)
+* @param    color   Color (16-bit)
+*/
+void band_fill_triangle(uint16_t x0, uint16_t y0,
+                        uint16_t x1, uint16_t y1,
+                        uint16_t x2, uint16_t y2,
+                        uint16_t color)
+{
+    raster_point_t points[3];
+
+    points[0].x = x0;
+    points[0].y = y0;
+    points[1].x = x1;
+    points[1].y = y1;
+    points[2].x = x2;
+    points[2].y = y2;
+
+    band_fill_polygon(&points[0], 3, color);
+}
+
+/**
+ * @brief   Draw filled polygon (even-odd rule)
+ * @param   points  Vertices in drawing order (closed implicitly)
+ * @param   count   Number of vertices (3 - RASTER_MAX_VERTICES)
+ * @param   color   Color (16-bit)
+ */
+void band_fill_polygon(const raster_point_t *points,
+                       uint8_t count,
+                       uint16_t color)
+{
+    raster_fill_polygon(raster_block, points, count, color);
+}
+
+/**
+ * @brief   Draw Rectangle Boundary without fill
+ * @param   x       Top left x coordinate
+ * @param   y       Top left y coordinate
+ * @param   length  Length of the rectangle
+ * @param   width   Width of the rectangle
+ * @param   color   Colour (16-bit)
+ */
+void band_draw_rectangle(uint16_t x, uint16_t y,
+                         uint16_t length, uint16_t width,
+                         uint16_t color)
+{
+    band_draw_horizontal_line(x, y, length, color);
+    band_draw_horizontal_line(x, y + width, length, color);
+    band_draw_vertical_line(x, y, width, color);
+    band_draw_vertical_line(x + length, y, width, color);
+}
+
+/**
+* @brief    Draw Triangle based on Coordinate (x0, y0), (x1, y1) & (x2, y2)
+*           without fill
+* @param    x0      first point (x-coordinate)
+* @param    y0      first point (y-coordinate)
+* @param    x1      second point (x-coordinate)
+* @param    y1      second point (y-coordinate)
+* @param    x2      third point (x-coordinate)
+* @param    y2      third point (y-coordinate)
+* @param    color   Color (16-bit)
+*/
+void band_draw_triangle(uint16_t x0, uint16_t y0,
+                        uint16_t x1, uint16_t y1,
+                        uint16_t x2, uint16_t y2,
+                        uint16_t color)
+{
+    band_draw_line(x0, y0, x1, y1,color);
+    band_draw_line(x0, y0, x2, y2,color);
+    band_draw_line(x1, y1, x2, y2,color);
+}
+
+/**
+ * @brief   Draw circle using center point (xc, yc) with radius,r
+ * @param   xc      Center point (x-coordinate)
+ * @param   yc      Center point (y-coordinate)
+ * @param   r       Radius
+ * @param   color   Color (16-bit)
+ */
+void band_draw_circle(uint16_t xc, uint16_t yc,
+                      uint16_t r,
+                      uint16_t color)
+{
+    int16_t x = -r;
+    int16_t y = 0;
+    int16_t err = 2 - 2 * r;
+    int16_t e2;
+
+    if (!rows_in_band((int32_t)yc - r, (int32_t)yc + r))
+    {
+        return;
+    }
+
+    do
+    {
+        fill_span(xc-x, xc-x, yc+y, color);
+        fill_span(xc+x, xc+x, yc+y, color);
+        fill_span(xc+x, xc+x, yc-y, color);
+        fill_span(xc-x, xc-x, yc-y, color);
+        e2 = err;
+        if (e2 <= y)
+        {
+            err += ++y * 2 + 1;
+            if (-x == y && e2 <= x)
+                e2 = 0;
+        }
+        if (e2 > x)
+            err += ++x * 2 + 1;
+    } while (x <= 0);
+}
+
+/**
+ * @brief   Draw ASCII charactar at (x,y) with foreground and background colour
+ * @param   ascii    ASCII Character. eg: 'A'
+ * @param   x        Starting x position
+ * @param   y        Starting y position
+ * @param   size     Size of the font
+ * @param   fgcolor  Foreground colour
+ * @param   bgcolor  Background colour
+ */
+void band_draw_char(uint8_t ascii, uint16_t x, uint16_t y,
+                    uint16_t size, uint16_t fgcolor, uint16_t bgcolor)
+{
+    const uint8_t *bitmap = glyph(ascii);
+    uint8_t i, f;
+
+    if (!rows_in_band(y, (int32_t)y + TFT_FONT_Y * size))
+    {
+        return;
+    }
+
+    for (i = 0; i < TFT_FONT_X; i++)
+    {
+        for (f = 0; f < 8; f++)
+        {
+            band_fill_rectangle(x + i * size, y + f * size, size, size,
+                                ((bitmap[i] >> f) & 0x01) ? fgcolor : bgcolor);
+        }
+    }
+}
+
+/**
+* @brief    Draw string at (x,y) with fill foreground and background color
+* @param    string    String input. Eg: "abc"
+* @param    x         x coordinate
+* @param    y         y coordinate
+* @param    size      font size
+* @param    fgcolor   foreground color
+* @param    bgcolor   background color
+*/
+void band_draw_string(char *string, uint16_t x, uint16_t y,
+                      uint16_t size, uint16_t fgcolor, uint16_t bgcolor)
+{
+    while(*string)
+    {
+        band_draw_char(*string, x, y, size, fgcolor, bgcolor);
+        string++;
+
+        if(x < band_info.width - 1)
+        {
+            x += TFT_FONT_SPACE * size;    /* Move cursor right            */
+        }
+    }
+}
+
+/**
+ * @brief   Print number character at (x,y) with foreground & background color
+ * @param   long_num    Number to be printed
+ * @param   x           x-coordinate
+ * @param   y           y-coordinate
+ * @param   size:       Size of the number text
+ * @param   fgcolor     Foreground color
+ * @param   bgcolor     Background color
+ * @return  The number of character printed for the number input
+ */
+uint8_t band_draw_number(int long_num, uint16_t x, uint16_t y,
+                         uint16_t size, uint16_t fgcolor, uint16_t bgcolor)
+{
+    uint8_t char_buffer[10] = "";
+    uint8_t i = 0;
+    uint8_t f = 0;
+
+    if (long_num < 0)
+    {
+        f = 1;
+        band_draw_char('-',x, y, size, fgcolor, bgcolor);
+        long_num = -long_num;
+        if(x < band_info.width - 1)
+        {
+            x += TFT_FONT_SPACE * size;
+        }
+    }
+    else if (long_num == 0)
+    {
+        band_draw_char('0', x, y, size, fgcolor, bgcolor);
+        return 1;
+    }
+
+    while (long_num > 0)
+    {
+        char_buffer[i++] = (uint8_t)(long_num % 10);
+        long_num /= 10;
+    }
+
+    f = f+i;
+    for(; i > 0; i--)
+    {
+        band_draw_char('0'+ char_buffer[i - 1], x, y, size, fgcolor, bgcolor);
+        if(x < band_info.width - 1)
+        {
+            /* Move the cursor to right */
+            x += TFT_FONT_SPACE*size;
+        }
+    }
+    return f;
+}
+
+/**
+ * @brief   Draw ASCII Character without background colour
+ * @param   ascii    ASCII Character ('G')
+ * @param   x        x coordinate
+ * @param   y        y coordinate
+ * @param   size     Font size
+ * @param   color    Font colour
+ */
+void band_draw_char_only(uint8_t ascii, uint16_t x, uint16_t y,
+                         uint16_t size, uint16_t color)
+{
+    const uint8_t *bitmap = glyph(ascii);
+    uint8_t col, row;
+
+    if (!rows_in_band(y, (int32_t)y + TFT_FONT_Y * size))
+    {
+        return;
+    }
+
+    for (row = 0; row < 8; row++)
+    {
+        for (col = 0; col < 8; col++)
+        {
+            if (bitmap[col] & (1 << row))
+            {
+                band_fill_rectangle(x + col * size, y + row * size,
+                                    size, size, color);
+            }
+        }
+    }
+}
+
+/**
+* @brief    Draw string at (x,y) without background colour
+* @param    string    String input. Eg: "abc"
+* @param    x         x coordinate
+* @param    y         y coordinate
+* @param    size      font size
+* @param    color     color
+*/
+void band_draw_string_only(char *string, uint16_t x, uint16_t y,
+                           uint16_t size, uint16_t color)
+{
+    while(*string)
+    {
+        band_draw_char_only(*string, x, y, size, color);
+        string++;
+
+        if(x < band_info.width - 1)
+        {
+            x += TFT_FONT_SPACE * size;
+        }
+    }
+}
+
+/**
+ * @brief   Render the tft_test drawing as one linear stream
+ */
+void band_test(void)
+{
+    band_render(test_scene, BLACK);
+}
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Band renderer initialisation
+ */
+void band_init(void)
+{
+    band_info.buffer = NULL;
+    band_info.y0 = 0;
+    band_info.y1 = -1;
+    band_info.width = 0;
+    band_info.height = 0;
+    band_info.strip = 0;
+}
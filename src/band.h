@@ -0,0 +1,103 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  band.h
+ *
+ *    Description:  Banded off-screen renderer header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 02:05:18 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef BAND_H
+#define BAND_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+#include "raster.h"
+
+/*-----------------------------------------------------------------------------
+ *  Event call-backs
+ *-----------------------------------------------------------------------------*/
+
+/*
+ * Scene drawing function
+ * Called once per band; it issues band_* primitives for the whole screen and
+ * only the rows of the current band are rasterised
+ */
+typedef void (*band_scene_t)(void);
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+void band_render(band_scene_t scene, uint16_t background);
+void band_clear(uint16_t color);
+void band_set_pixel(uint16_t x, uint16_t y, uint16_t color);
+void band_fill_area(uint16_t x0, uint16_t y0,
+                    uint16_t x1, uint16_t y1,
+                    uint16_t color);
+void band_draw_horizontal_line(uint16_t x, uint16_t y,
+                               uint16_t length,
+                               uint16_t color);
+void band_draw_vertical_line(uint16_t x, uint16_t y,
+                             uint16_t length,
+                             uint16_t color);
+void band_draw_line(uint16_t x0, uint16_t y0,
+                    uint16_t x1, uint16_t y1,
+                    uint16_t color);
+void band_fill_rectangle(uint16_t x, uint16_t y,
+                         uint16_t length, uint16_t width,
+                         uint16_t color);
+void band_fill_circle(uint16_t xc, uint16_t yc,
+                      int16_t r,
+                      uint16_t color);
+void band_fill_triangle(uint16_t x0, uint16_t y0,
+                        uint16_t x1, uint16_t y1,
+                        uint16_t x2, uint16_t y2,
+                        uint16_t color);
+void band_fill_polygon(const raster_point_t *points,
+                       uint8_t count,
+                       uint16_t color);
+void band_draw_rectangle(uint16_t x, uint16_t y,
+                         uint16_t length, uint16_t width,
+                         uint16_t color);
+void band_draw_triangle(uint16_t x0, uint16_t y0,
+                        uint16_t x1, uint16_t y1,
+                        uint16_t x2, uint16_t y2,
+                        uint16_t color);
+void band_draw_circle(uint16_t xc, uint16_t yc,
+                      uint16_t r,
+                      uint16_t color);
+void band_draw_char(uint8_t ascii, uint16_t x, uint16_t y,
+                    uint16_t size, uint16_t fgcolor, uint16_t bgcolor);
+void band_draw_string(char *string, uint16_t x, uint16_t y,
+                      uint16_t size, uint16_t fgcolor, uint16_t bgcolor);
+uint8_t band_draw_number(int long_num, uint16_t x, uint16_t y,
+                         uint16_t size, uint16_t fgcolor, uint16_t bgcolor);
+void band_draw_char_only(uint8_t ascii, uint16_t x, uint16_t y,
+                         uint16_t size, uint16_t color);
+void band_draw_string_only(char *string, uint16_t x, uint16_t y,
+                           uint16_t size, uint16_t color);
+void band_test(void);
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+void band_init(void);
+
+#endif
@@ -0,0 +1,267 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  chart.c
+ *
+ *    Description:  Strip-chart widget implementation file
+ *                  The host registers a chart region once and then sends
+ *                  only new samples. Each sample draws one column: the
+ *                  segment from the previous sample on background.
+ *                  A chart covering the full screen height in landscape
+ *                  is scrolled by the controller (new column at the right
+ *                  edge), other charts sweep a ring-indexed column cursor
+ *                  across the region.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 08:14:37 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "chart.h"
+#include "tft.h"
+#include "setting.h"
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    /* Chart is registered */
+    bool     used;
+
+    /* Region */
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+
+    /* Sample values at the bottom and top of the region */
+    int16_t  min_value;
+    int16_t  max_value;
+
+    uint16_t fgcolor;
+    uint16_t bgcolor;
+
+    /* Region is scrolled by hardware */
+    bool     scroll;
+
+    /* Next column of the region (ring cursor, 0 - width - 1) */
+    uint16_t cursor;
+
+    /* Row of the previous sample (valid if has_last) */
+    uint16_t last_row;
+    bool     has_last;
+} chart_info_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static chart_info_t chart_info[CHART_COUNT];
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Screen row of a sample value, clamped to the region
+ * @param   chart   Chart
+ * @param   value   Sample value
+ * @return  Row (y coordinate)
+ */
+static uint16_t sample_row(const chart_info_t *chart, int16_t value)
+{
+    int32_t span = (int32_t)chart->max_value - chart->min_value;
+    int32_t level;
+
+    value = constrain(value, chart->min_value, chart->max_value);
+
+    /* Rounded to the nearest row, max_value is the top row */
+    level = (((int32_t)value - chart->min_value) * (chart->height - 1) +
+             span / 2) / span;
+
+    return chart->y + chart->height - 1 - (uint16_t)level;
+}
+
+/**
+ * @brief   Draw one chart column: segment from row0 to row1 on background
+ * @param   chart   Chart
+ * @param   x       Column
+ * @param   row0    Segment end
+ * @param   row1    Other segment end
+ */
+static void draw_column(const chart_info_t *chart, uint16_t x,
+                        uint16_t row0, uint16_t row1)
+{
+    uint16_t top = min(row0, row1);
+    uint16_t bottom = max(row0, row1);
+
+    if (top > chart->y)
+    {
+        tft_fill_area(x, chart->y, x, top - 1, chart->bgcolor);
+    }
+
+    tft_fill_area(x, top, x, bottom, chart->fgcolor);
+
+    if (bottom < chart->y + chart->height - 1)
+    {
+        tft_fill_area(x, bottom + 1, x, chart->y + chart->height - 1,
+                      chart->bgcolor);
+    }
+}
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Register a chart and clear its region
+ *          A chart spanning the full height of a landscape screen uses
+ *          hardware scrolling (one chart at a time)
+ * @param   id      Chart ID (0 - CHART_COUNT - 1)
+ * @param   region  Region (one column per sample), sample values at the
+ *                  bottom and top rows, trace and background colours
+ * @return  True if registered
+ */
+bool chart_register(uint8_t id, const chart_region_t *region)
+{
+    chart_info_t *chart;
+
+    ASSERT(region != NULL);
+
+    if ((id >= CHART_COUNT) ||
+        (region->width == 0) || (region->height == 0) ||
+        (region->min_value >= region->max_value) ||
+        ((uint32_t)region->x + region->width > tft_get_width()) ||
+        ((uint32_t)region->y + region->height > tft_get_height()))
+    {
+        return false;
+    }
+
+    chart_remove(id);
+
+    chart = &chart_info[id];
+    chart->x = region->x;
+    chart->y = region->y;
+    chart->width = region->width;
+    chart->height = region->height;
+    chart->min_value = region->min_value;
+    chart->max_value = region->max_value;
+    chart->fgcolor = region->fgcolor;
+    chart->bgcolor = region->bgcolor;
+    chart->cursor = 0;
+    chart->has_last = false;
+    chart->used = true;
+
+    /* Landscape scrolls along x, the band must span the screen height */
+    chart->scroll = (tft_get_width() > tft_get_height()) &&
+                    (chart->y == 0) && (chart->height == tft_get_height()) &&
+                    tft_scroll_begin(chart->x, chart->width);
+
+    tft_fill_area(chart->x, chart->y,
+                  chart->x + chart->width - 1, chart->y + chart->height - 1,
+                  chart->bgcolor);
+
+    return true;
+}
+
+/**
+ * @brief   Remove a chart (its region is left as drawn)
+ * @param   id      Chart ID
+ */
+void chart_remove(uint8_t id)
+{
+    chart_info_t *chart;
+
+    if (id >= CHART_COUNT)
+    {
+        return;
+    }
+
+    chart = &chart_info[id];
+
+    if (chart->used && chart->scroll)
+    {
+        tft_scroll_end();
+    }
+
+    chart->used = false;
+    chart->scroll = false;
+}
+
+/**
+ * @brief   Add a sample to a chart
+ *          Only the column of the new sample is written
+ * @param   id      Chart ID
+ * @param   value   Sample value
+ */
+void chart_add_sample(uint8_t id, int16_t value)
+{
+    chart_info_t *chart;
+    uint16_t row;
+    uint16_t x;
+
+    if ((id >= CHART_COUNT) || !chart_info[id].used)
+    {
+        return;
+    }
+
+    chart = &chart_info[id];
+    row = sample_row(chart, value);
+
+    if (chart->scroll)
+    {
+        /* Oldest column, shown at the right edge once scrolled */
+        x = tft_scroll_line();
+    }
+    else
+    {
+        x = chart->x + chart->cursor;
+        chart->cursor = (chart->cursor + 1) % chart->width;
+
+        /* Do not join the trace across the wrap */
+        if (x == chart->x)
+        {
+            chart->has_last = false;
+        }
+    }
+
+    draw_column(chart, x, chart->has_last ? chart->last_row : row, row);
+
+    if (chart->scroll)
+    {
+        tft_scroll_step();
+    }
+
+    chart->last_row = row;
+    chart->has_last = true;
+}
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Chart initialisation
+ */
+void chart_init(void)
+{
+    uint8_t id;
+
+    for (id = 0; id < CHART_COUNT; id++)
+    {
+        chart_info[id].used = false;
+        chart_info[id].scroll = false;
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  chart.h
+ *
+ *    Description:  Strip-chart widget header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 08:14:37 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef CHART_H
+#define CHART_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+
+/*-----------------------------------------------------------------------------
+ *  Types
+ *-----------------------------------------------------------------------------*/
+
+/* Region, value range and colours of a chart */
+typedef struct
+{
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+
+    /* Sample values at the bottom and top rows */
+    int16_t  min_value;
+    int16_t  max_value;
+
+    uint16_t fgcolor;
+    uint16_t bgcolor;
+} chart_region_t;
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+bool chart_register(uint8_t id, const chart_region_t *region);
+void chart_remove(uint8_t id);
+void chart_add_sample(uint8_t id, int16_t value);
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+void chart_init(void);
+
+#endif
@@ -26,6 +26,15 @@
 #include "cmd_parser.h"
 #include "ringbuf.h"
 #include "setting.h"
+#include "dlist.h"
+#include "font.h"
+#include "chart.h"
+#include "scope.h"
+#include "numfield.h"
+#include "qoi.h"
+#include "jpeg.h"
+#include "tilemap.h"
+#include "sprite.h"
 
 /*-----------------------------------------------------------------------------
  *  Configuration
@@ -61,11 +70,289 @@ enum
     STR_FONT_SIZE,
     STR_COLOR_HIGH,
     STR_COLOR_LOW,
+    STR_FONT_ID,
+    STR_BGCOLOR_HIGH,
+    STR_BGCOLOR_LOW,
     STR_TEXT
 };
 
+/* Definition of CMD FRM data */
+enum
+{
+    FRM_END = 0U,
+    FRM_BEGIN
+};
+
+/* Definition of CMD TRM operation (first data byte) */
+enum
+{
+    TRM_STOP = 0U,
+    TRM_START,
+    TRM_WRITE
+};
+
+/* Definition of CMD TRM START index */
+enum
+{
+    TRM_OP = 0U,
+    TRM_TOP_HIGH,
+    TRM_TOP_LOW,
+    TRM_BOTTOM_HIGH,
+    TRM_BOTTOM_LOW,
+    TRM_FONT_SIZE,
+    TRM_COLOR_HIGH,
+    TRM_COLOR_LOW,
+    TRM_BGCOLOR_HIGH,
+    TRM_BGCOLOR_LOW,
+    TRM_START_SIZE
+};
+
+/* Definition of CMD TRM WRITE index */
+#define TRM_TEXT        (1U)
+
+/* Definition of CMD CHR operation and param index */
+enum
+{
+    CHR_REGISTER = 0U,
+    CHR_SAMPLE,
+    CHR_REMOVE
+};
+
+enum
+{
+    CHR_OP = 0U,
+    CHR_ID,
+    CHR_PARAM_SIZE
+};
+
+/* Definition of CMD SCP operation (param index as CMD CHR) */
+enum
+{
+    SCP_REGISTER = 0U,
+    SCP_TRACE8,
+    SCP_TRACE16,
+    SCP_REMOVE
+};
+
+/* Definition of CMD CHR / CMD SCP REGISTER data index */
+enum
+{
+    CHR_X_HIGH = 0U,
+    CHR_X_LOW,
+    CHR_Y_HIGH,
+    CHR_Y_LOW,
+    CHR_WIDTH_HIGH,
+    CHR_WIDTH_LOW,
+    CHR_HEIGHT_HIGH,
+    CHR_HEIGHT_LOW,
+    CHR_MIN_HIGH,
+    CHR_MIN_LOW,
+    CHR_MAX_HIGH,
+    CHR_MAX_LOW,
+    CHR_COLOR_HIGH,
+    CHR_COLOR_LOW,
+    CHR_BGCOLOR_HIGH,
+    CHR_BGCOLOR_LOW,
+    CHR_REGISTER_SIZE
+};
+
+/* Definition of CMD FLD index */
+enum
+{
+    FLD_ID = 0U,
+    FLD_X_HIGH,
+    FLD_X_LOW,
+    FLD_Y_HIGH,
+    FLD_Y_LOW,
+    FLD_FONT_SIZE,
+    FLD_COLOR_HIGH,
+    FLD_COLOR_LOW,
+    FLD_BGCOLOR_HIGH,
+    FLD_BGCOLOR_LOW,
+    FLD_WIDTH,
+    FLD_ALIGN,
+    FLD_SIZE
+};
+
+/* Definition of CMD NUM index (value is signed, MSB first) */
+enum
+{
+    NUM_ID = 0U,
+    NUM_VALUE,
+    NUM_SIZE = 5U
+};
+
+/* Definition of CMD AST index */
+enum
+{
+    AST_ID = 0U,
+    AST_X_HIGH,
+    AST_X_LOW,
+    AST_Y_HIGH,
+    AST_Y_LOW,
+    AST_SIZE
+};
+
+/* Definition of image (CMD IMG, QOI, RLE, PAL, MSK) parameter index */
+enum
+{
+    IMAGE_X_HIGH = 0U,
+    IMAGE_X_LOW,
+    IMAGE_Y_HIGH,
+    IMAGE_Y_LOW,
+    IMAGE_WIDTH_HIGH,
+    IMAGE_WIDTH_LOW,
+    IMAGE_HEIGHT_HIGH,
+    IMAGE_HEIGHT_LOW,
+    IMAGE_PARAM_SIZE
+};
+
+/* Definition of CMD IMG parameter index (after the image parameters) */
+enum
+{
+    IMG_SCALE_X = IMAGE_PARAM_SIZE,
+    IMG_SCALE_Y,
+    IMG_PARAM_SIZE
+};
+
+/* Definition of CMD PAL parameter index (after the image parameters) */
+enum
+{
+    PAL_BPP = IMAGE_PARAM_SIZE,
+    PAL_ENTRIES,
+    PAL_PARAM_SIZE
+};
+
+/* Definition of CMD MSK parameter index (after the image parameters) */
+enum
+{
+    MSK_COLOR_HIGH = IMAGE_PARAM_SIZE,
+    MSK_COLOR_LOW,
+    MSK_BGCOLOR_HIGH,
+    MSK_BGCOLOR_LOW,
+    MSK_FLAGS,
+    MSK_PARAM_SIZE
+};
+
+/* Definition of CMD JPG parameter index (JPEG file follows) */
+enum
+{
+    JPG_X_HIGH = 0U,
+    JPG_X_LOW,
+    JPG_Y_HIGH,
+    JPG_Y_LOW,
+    JPG_PARAM_SIZE
+};
+
+/* Definition of CMD TIL parameter index (palette and tiles follow) */
+enum
+{
+    TIL_SIZE = 0U,
+    TIL_BPP,
+    TIL_FIRST,
+    TIL_PARAM_SIZE
+};
+
+/* Definition of CMD MAP parameter index (tile indices follow) */
+enum
+{
+    MAP_X_HIGH = 0U,
+    MAP_X_LOW,
+    MAP_Y_HIGH,
+    MAP_Y_LOW,
+    MAP_COLS,
+    MAP_ROWS,
+    MAP_PARAM_SIZE
+};
+
+/* Definition of CMD CEL index (repeated for every cell) */
+enum
+{
+    CEL_COL = 0U,
+    CEL_ROW,
+    CEL_TILE,
+    CEL_SIZE
+};
+
+/* Definition of CMD ATL parameter index (palette and atlas follow) */
+enum
+{
+    ATL_WIDTH_HIGH = 0U,
+    ATL_WIDTH_LOW,
+    ATL_HEIGHT_HIGH,
+    ATL_HEIGHT_LOW,
+    ATL_BPP,
+    ATL_PARAM_SIZE
+};
+
+/* Definition of CMD SPR index */
+enum
+{
+    SPR_ID = 0U,
+    SPR_SX_HIGH,
+    SPR_SX_LOW,
+    SPR_SY_HIGH,
+    SPR_SY_LOW,
+    SPR_WIDTH,
+    SPR_HEIGHT,
+    SPR_X_HIGH,
+    SPR_X_LOW,
+    SPR_Y_HIGH,
+    SPR_Y_LOW,
+    SPR_Z,
+    SPR_FLAGS,
+    SPR_BGCOLOR_HIGH,
+    SPR_BGCOLOR_LOW,
+    SPR_SIZE
+};
+
+/* Definition of CMD MOV index (repeated for every moved sprite) */
+enum
+{
+    MOV_ID = 0U,
+    MOV_X_HIGH,
+    MOV_X_LOW,
+    MOV_Y_HIGH,
+    MOV_Y_LOW,
+    MOV_SIZE
+};
+
+/* Definition of CMD STA reply index (32-bit counters, MSB first) */
+enum
+{
+    STA_GLYPH_HITS = 0U,
+    STA_GLYPH_MISSES = 4U,
+    STA_SAVED_BYTES = 8U,
+    STA_SIZE = 12U
+};
+
 #define MSG_SIZE        (512U)
 
+/* Image pixel buffer size (pixels), two buffers are used in ping-pong */
+#define PIXEL_CHUNK_SIZE    (64U)
+
+/* Image runs from this length on are sent as one burst */
+#define PIXEL_BURST_SIZE    (32U)
+
+/* Largest image scale factor (CMD IMG) */
+#define IMG_MAX_SCALE       (8U)
+
+/* Widest scaled image row (screen width in landscape) */
+#define IMAGE_LINE_SIZE     (320U)
+
+/* RLE run token flag */
+#define RLE_RUN             (0x80U)
+
+/* Largest palette of an indexed image */
+#define PALETTE_SIZE        (256U)
+
+/* CMD MSK flags: clear bits are not drawn */
+#define MSK_TRANSPARENT     (0x01U)
+
+/* CMD SPR flags: sprite is drawn, background is the tile map */
+#define SPR_VISIBLE         (0x01U)
+#define SPR_TILE_BG         (0x02U)
+
 /*-----------------------------------------------------------------------------
  *  Private Types
  *-----------------------------------------------------------------------------*/
@@ -89,6 +376,25 @@ typedef enum
     CMD_CLR,
     CMD_RAW,
     CMD_SQB,
+    CMD_FRM,
+    CMD_STA,
+    CMD_TRM,
+    CMD_CHR,
+    CMD_SCP,
+    CMD_FLD,
+    CMD_NUM,
+    CMD_AST,
+    CMD_QOI,
+    CMD_RLE,
+    CMD_PAL,
+    CMD_MSK,
+    CMD_JPG,
+    CMD_TIL,
+    CMD_MAP,
+    CMD_CEL,
+    CMD_ATL,
+    CMD_SPR,
+    CMD_MOV,
     MAX_CMD
 } cmd_t;
 
@@ -149,6 +455,77 @@ typedef struct
     uint16_t n_count;
 } sqb_info_t;
 
+typedef struct
+{
+    uint8_t op;
+    uint8_t id;
+
+    /* Parsed REGISTER fields (kept off the stack) */
+    chart_region_t region;
+} chr_info_t;
+
+/* Compressed image byte expected next */
+typedef enum
+{
+    IMAGE_TOKEN,
+    IMAGE_RUN_HIGH,
+    IMAGE_RUN_LOW,
+    IMAGE_LITERAL_HIGH,
+    IMAGE_LITERAL_LOW,
+    IMAGE_INDEX
+} image_state_t;
+
+/* Image decoding (CMD IMG, RLE, PAL) */
+typedef struct
+{
+    image_state_t state;
+
+    /* RLE: pixels left in the token */
+    uint8_t       count;
+
+    /* High byte waiting for its low byte */
+    uint8_t       high_byte;
+
+    /* PAL: bits per index */
+    uint8_t       bpp;
+
+    /* PAL: palette entries sent and received */
+    uint16_t      entries;
+    uint16_t      entry;
+
+    /* PAL, IMG: image width and column of the next pixel */
+    uint16_t      width;
+    uint16_t      column;
+
+    /* IMG: pixel width and height (scale factors) */
+    uint8_t       sx;
+    uint8_t       sy;
+
+    /* IMG: pixels in the scaled row */
+    uint16_t      scaled;
+} image_info_t;
+
+/* Mask being received (CMD MSK) */
+typedef struct
+{
+    /* Mask rectangle */
+    uint16_t x0;
+    uint16_t y0;
+    uint16_t x1;
+    uint16_t y1;
+
+    uint16_t fgcolor;
+    uint16_t bgcolor;
+    bool     transparent;
+
+    /* Bytes per row, and bytes of the current row received */
+    uint16_t stride;
+    uint16_t received;
+
+    /* Current row */
+    uint16_t row;
+} mask_info_t;
+
 /* Function Pointer for Command Parser State Action */
 typedef void (*cmd_state_action_t)(uint8_t byte);
 
@@ -173,16 +550,54 @@ static bool str_action(uint8_t byte);
 static bool clr_action(uint8_t byte);
 static bool raw_action(uint8_t byte);
 static bool sqb_action(uint8_t byte);
+static bool frm_action(uint8_t byte);
+static bool sta_action(uint8_t byte);
+static bool trm_action(uint8_t byte);
+static bool chr_action(uint8_t byte);
+static bool scp_action(uint8_t byte);
+static bool fld_action(uint8_t byte);
+static bool num_action(uint8_t byte);
+static bool ast_action(uint8_t byte);
+static bool qoi_action(uint8_t byte);
+static bool rle_action(uint8_t byte);
+static bool pal_action(uint8_t byte);
+static bool msk_action(uint8_t byte);
+static bool jpg_action(uint8_t byte);
+static bool til_action(uint8_t byte);
+static bool map_action(uint8_t byte);
+static bool cel_action(uint8_t byte);
+static bool atl_action(uint8_t byte);
+static bool spr_action(uint8_t byte);
+static bool mov_action(uint8_t byte);
 
 /* Command Table to store command list with expected minimum data size */
 static const cmd_definition_t cmd_table[MAX_CMD] = 
 {
     {CMD_BLK, 10},
-    {CMD_IMG, 8},
-    {CMD_STR, 8},
+    {CMD_IMG, IMG_PARAM_SIZE},
+    {CMD_STR, 11},
     {CMD_CLR, 0},
     {CMD_RAW, 0},
-    {CMD_SQB, 0}
+    {CMD_SQB, 0},
+    {CMD_FRM, 1},
+    {CMD_STA, 0},
+    {CMD_TRM, 1},
+    {CMD_CHR, 2},
+    {CMD_SCP, 2},
+    {CMD_FLD, FLD_SIZE},
+    {CMD_NUM, NUM_SIZE},
+    {CMD_AST, AST_SIZE},
+    {CMD_QOI, IMAGE_PARAM_SIZE},
+    {CMD_RLE, IMAGE_PARAM_SIZE},
+    {CMD_PAL, PAL_PARAM_SIZE},
+    {CMD_MSK, MSK_PARAM_SIZE},
+    {CMD_JPG, JPG_PARAM_SIZE},
+    {CMD_TIL, TIL_PARAM_SIZE},
+    {CMD_MAP, MAP_PARAM_SIZE},
+    {CMD_CEL, CEL_SIZE},
+    {CMD_ATL, ATL_PARAM_SIZE},
+    {CMD_SPR, SPR_SIZE},
+    {CMD_MOV, MOV_SIZE}
 };
 
 static const cmd_invoke_action_t cmd_invoke[] =
@@ -192,7 +607,26 @@ static const cmd_invoke_action_t cmd_invoke[] =
     /* CMD_STR */   str_action,
     /* CMD_CLR */   clr_action,
     /* CMD_RAW */   raw_action,
-    /* CMD_SQB */   sqb_action
+    /* CMD_SQB */   sqb_action,
+    /* CMD_FRM */   frm_action,
+    /* CMD_STA */   sta_action,
+    /* CMD_TRM */   trm_action,
+    /* CMD_CHR */   chr_action,
+    /* CMD_SCP */   scp_action,
+    /* CMD_FLD */   fld_action,
+    /* CMD_NUM */   num_action,
+    /* CMD_AST */   ast_action,
+    /* CMD_QOI */   qoi_action,
+    /* CMD_RLE */   rle_action,
+    /* CMD_PAL */   pal_action,
+    /* CMD_MSK */   msk_action,
+    /* CMD_JPG */   jpg_action,
+    /* CMD_TIL */   til_action,
+    /* CMD_MAP */   map_action,
+    /* CMD_CEL */   cel_action,
+    /* CMD_ATL */   atl_action,
+    /* CMD_SPR */   spr_action,
+    /* CMD_MOV */   mov_action
 };
 
 /* Table storing command state function */
@@ -209,14 +643,42 @@ static const cmd_state_action_t cmd_state_table[] =
 static uint8_t data[MSG_SIZE];
 static char text[256] = "";
 
+/* Image pixels, one buffer is filled while uDMA sends the other */
+static uint16_t pixel_chunk[2][PIXEL_CHUNK_SIZE];
+static uint8_t  pixel_chunk_index;
+static uint32_t pixel_chunk_size;
+
+/* Image high byte waiting for its low byte */
+static uint8_t  pixel_high_byte;
+static bool     pixel_byte_pending;
+
+/* Compressed image: pixels still to be decoded */
+static uint32_t pixel_remaining;
+
+/* Scaled image rows, one is filled while uDMA sends the other */
+static uint16_t image_line[2][IMAGE_LINE_SIZE];
+static uint8_t  image_line_index;
+
+/* Colour look-up table of a palette-indexed image */
+static uint16_t palette[PALETTE_SIZE];
+
 /* Structure Info */
 static cmd_info_t       cmd_info;
 static sqb_info_t       sqb_info;
+static chr_info_t       chr_info;
+static image_info_t     image_info;
+static mask_info_t      mask_info;
+
+/* Parsed SPR fields (kept off the stack) */
+static sprite_params_t  sprite_params;
 
 /* Command State */
 static parse_state_t    parse_state;
 static raw_state_t      raw_state;
 
+/* Payload of a rejected command is skipped in STATE_DATA */
+static bool             parse_discard;
+
 #ifdef UART_CMD_0
 static uart_instance_t uart_type = UART_0;
 #endif
@@ -451,7 +913,7 @@ static bool blk_action(uint8_t byte)
         color = convert_to_word(data[BLK_COLOR_HIGH],
                                 data[BLK_COLOR_LOW]);
     
-        tft_fill_area(x0, y0, x1, y1, color);
+        dlist_fill_area(x0, y0, x1, y1, color);
 
         last_data = true;
 
@@ -460,21 +922,63 @@ static bool blk_action(uint8_t byte)
     return last_data;
 }
 
+/**
+ * @brief   Send the scaled image row built so far
+ *          The next row is built in the other line buffer
+ * @param   rows    Number of times the row is sent
+ */
+static void image_scaled_send(uint8_t rows)
+{
+    uint16_t *line = &image_line[image_line_index][0];
+    uint8_t i;
+
+    for (i = 0; i < rows; i++)
+    {
+        tft_send_pixels(line, image_info.scaled);
+    }
+
+    image_line_index ^= 1;
+    image_info.column = 0;
+    image_info.scaled = 0;
+}
+
+/**
+ * @brief   Add a pixel to the scaled image row
+ *          The pixel is repeated sx times, a complete row is sent sy times
+ * @param   color   Colour (16-bit)
+ */
+static void image_scaled_put(uint16_t color)
+{
+    uint16_t *line = &image_line[image_line_index][0];
+    uint8_t i;
+
+    for (i = 0; (i < image_info.sx) && (image_info.scaled < IMAGE_LINE_SIZE); i++)
+    {
+        line[image_info.scaled++] = color;
+    }
+
+    if (++image_info.column == image_info.width)
+    {
+        image_scaled_send(image_info.sy);
+    }
+}
+
 /**
  * @brief   Image Action (Draw Image Command)
+ *          x(H), x(L), y(H), y(L), w(H), w(L), h(H), h(L), sx, sy,
+ *          16bit-pixel...
+ *          Every pixel is drawn sx pixels wide and sy pixels high (1 - 8)
+ *          within one window
  * @param   byte    received byte
  * @return  True if the received byte is the last data byte
  */
 static bool img_action(uint8_t byte)
 {
-    /* x(H), x(L), y(H), y(L), h(H), h(L), w(H), w(L), 16bit-pixel */
-
     bool last_data = false;
-    uint16_t height = 0;
-    uint16_t width = 0;
-    uint16_t x = 0;
-    uint16_t y = 0;
-    uint8_t temp[8];
+    uint16_t height;
+    uint16_t width;
+    uint16_t x;
+    uint16_t y;
 
     /*
      * Sending Image Pixel
@@ -482,53 +986,109 @@ static bool img_action(uint8_t byte)
      */
     if (parse_state == STATE_DATA)
     {
-        /* Transfer pixel information */
-        tft_send_data_only(byte);
+        /* Scaled image, rows are built in the line buffers */
+        if ((image_info.sx > 1) || (image_info.sy > 1))
+        {
+            if (pixel_byte_pending)
+            {
+                image_scaled_put(convert_to_word(pixel_high_byte, byte));
+                pixel_byte_pending = false;
+            }
+            else
+            {
+                pixel_high_byte = byte;
+                pixel_byte_pending = true;
+            }
+
+            /* Short image, the partial last row is sent once as the
+             * unscaled path does, the rest of the window is left as it is */
+            if ((image_info.scaled > 0) &&
+                (cmd_info.current_data == cmd_info.data_size))
+            {
+                image_scaled_send(1);
+            }
+        }
+        else
+        {
+            /* Pair bytes into RGB565 pixels (MSB first) */
+            if (pixel_byte_pending)
+            {
+                pixel_chunk[pixel_chunk_index][pixel_chunk_size++] =
+                    convert_to_word(pixel_high_byte, byte);
+                pixel_byte_pending = false;
+            }
+            else
+            {
+                pixel_high_byte = byte;
+                pixel_byte_pending = true;
+            }
+
+            /* Hand the full buffer to uDMA and fill the other one */
+            if ((pixel_chunk_size == PIXEL_CHUNK_SIZE) ||
+                (cmd_info.current_data == cmd_info.data_size))
+            {
+                tft_send_pixels(&pixel_chunk[pixel_chunk_index][0],
+                                pixel_chunk_size);
+                pixel_chunk_index ^= 1;
+                pixel_chunk_size = 0;
+            }
+
+            /* Odd trailing byte */
+            if (pixel_byte_pending &&
+                (cmd_info.current_data == cmd_info.data_size))
+            {
+                tft_send_data_only(pixel_high_byte);
+                pixel_byte_pending = false;
+            }
+        }
     }
     /* Getting Image Parameter */
     else
     {
-        /* Buffer the first 7 byte (MSB first) */
-        if (RingBufUsed(&cmd_info.data_ringbuf_obj) < 7)
-        {
-            RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
-        }
-        else
-        /* The 8th byte */
+        RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == IMG_PARAM_SIZE)
         {
-            RingBufRead(&cmd_info.data_ringbuf_obj, &temp[0], 7);
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], IMG_PARAM_SIZE);
             ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
 
-            /* Get starting x and y position */
-            x |= (((uint16_t)temp[0]) << 8);
-            x |= (((uint16_t)temp[1]) & 0xFF);
-            y |= (((uint16_t)temp[2]) << 8);
-            y |= (((uint16_t)temp[3]) & 0xFF);
+            x = convert_to_word(data[IMAGE_X_HIGH], data[IMAGE_X_LOW]);
+            y = convert_to_word(data[IMAGE_Y_HIGH], data[IMAGE_Y_LOW]);
+            width = convert_to_word(data[IMAGE_WIDTH_HIGH], data[IMAGE_WIDTH_LOW]);
+            height = convert_to_word(data[IMAGE_HEIGHT_HIGH], data[IMAGE_HEIGHT_LOW]);
 
-            /* Get Height and Width */
-            height |= (((uint16_t)temp[4]) << 8);
-            height |= (((uint16_t)temp[5]) & 0xFF);
-            width |= (((uint16_t)temp[6]) << 8);
-            width |= (((uint16_t)byte) & 0xFF);
+            image_info.sx = constrain(data[IMG_SCALE_X], 1, IMG_MAX_SCALE);
+            image_info.sy = constrain(data[IMG_SCALE_Y], 1, IMG_MAX_SCALE);
+            image_info.width = width;
+            image_info.column = 0;
+            image_info.scaled = 0;
+
+            /* Scaled rows are cut to the line buffer */
+            width = min((uint32_t)width * image_info.sx, IMAGE_LINE_SIZE);
+            height = height * image_info.sy;
 
             /* Change to Image Pixel State */
             parse_state = STATE_DATA;
+            pixel_chunk_size = 0;
+            pixel_byte_pending = false;
 
-            /* Set the area to be filled */
-            uint16_t x1 = x + width - 1;
-            uint16_t y1 = y + height - 1;
+            /* Image is not recorded, draw the frame so far first */
+            dlist_immediate();
 
             /* Start image transaction by setting area boundary */
-            tft_start_image_transfer(x, y, x1, y1);
-
+            tft_start_image_transfer(x, y, x + width - 1, y + height - 1);
         }
     }
 
     /* Check if it's last byte */
     if (cmd_info.current_data == cmd_info.data_size)
     {
+        if (parse_state == STATE_DATA)
+        {
+            tft_done_transfer();
+        }
+
         parse_state = STATE_PARAM;
-        tft_done_transfer();
 
         last_data = true;
     }
@@ -550,6 +1110,9 @@ static bool raw_action(uint8_t byte)
     {
         raw_state = STATE_SEND_DATA;
 
+        /* Raw command is not recorded, draw the frame so far first */
+        dlist_immediate();
+
         /* Transfer raw command */
         tft_send_command(byte);
     }
@@ -580,14 +1143,17 @@ static bool str_action(uint8_t byte)
 {
     ASSERT(cmd_info.cmd.name == CMD_STR);
 
-    /* x(H) ,x(L) ,y(H), y(L), font_size, color(H), color(L), text.... */
+    /* x(H) ,x(L) ,y(H), y(L), font_size, color(H), color(L), font_id,
+     * bgcolor(H), bgcolor(L), text.... */
 
     bool last_data = false;
     uint16_t x;
     uint16_t y;
     uint16_t font_size;
     uint16_t color;
-    uint8_t text_size = cmd_info.data_size - 7;
+    uint8_t  font_id;
+    uint16_t bgcolor;
+    uint8_t text_size = cmd_info.data_size - STR_TEXT;
 
     /* Buffer the param byte */
     RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
@@ -609,16 +1175,33 @@ static bool str_action(uint8_t byte)
         color = convert_to_word(data[STR_COLOR_HIGH],
                                 data[STR_COLOR_LOW]);
 
+        font_id = data[STR_FONT_ID];
+
+        bgcolor = convert_to_word(data[STR_BGCOLOR_HIGH],
+                                  data[STR_BGCOLOR_LOW]);
+
         /*
-         * Size = total data byte size - 7
-         * 6 = x(H) ,x(L) ,y(H), y(L), font_size, color(H), color(L)
+         * Size = total data byte size - 10
+         * 10 = x(H) ,x(L) ,y(H), y(L), font_size, color(H), color(L),
+         *      font_id, bgcolor(H), bgcolor(L)
          */
         memcpy(&text[0], &data[STR_TEXT], text_size);
 
         /* Set Null termination at the last character */
         text[text_size] = 0;
 
-        tft_draw_string_only(&text[0], x, y, font_size, color);
+        if (font_id == FONT_BUILTIN)
+        {
+            /* Scaled font_map without background (bgcolor unused) */
+            dlist_draw_string_only(&text[0], x, y, font_size, color);
+        }
+        else
+        {
+            /* Generated fonts are not recorded (font_size unused) */
+            dlist_immediate();
+
+            font_draw_string(font_id, &text[0], x, y, color, bgcolor);
+        }
 
         last_data = true;
     }
@@ -636,7 +1219,7 @@ static bool clr_action(uint8_t byte)
     ASSERT(cmd_info.cmd.name == CMD_CLR);
     ASSERT(byte == 0);
     
-    tft_clear_screen();
+    dlist_clear_screen();
 
     return true;
 }
@@ -680,7 +1263,7 @@ static bool sqb_action(uint8_t byte)
             uint16_t y1 = y0 + sqb_info.y_size;
 
             /* Draw Block */
-            tft_fill_area(x0, y0, x1, y1, sqb_info.color);
+            dlist_fill_area(x0, y0, x1, y1, sqb_info.color);
         }
     }
     /* Getting Repeated Block Parameter - STATE_PARAM */
@@ -719,6 +1302,1193 @@ static bool sqb_action(uint8_t byte)
     return last_data;
 }
 
+/**
+ * @brief   Frame Action (Begin/End display list recording Command)
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool frm_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_FRM);
+
+    /* FRM_BEGIN / FRM_END */
+    if (byte == FRM_BEGIN)
+    {
+        dlist_begin();
+    }
+    else
+    {
+        dlist_end();
+    }
+
+    return (cmd_info.current_data == cmd_info.data_size);
+}
+
+/**
+ * @brief   Put a 32-bit value (MSB first) into a buffer
+ * @param   buffer  Output buffer (4 bytes)
+ * @param   value   Value
+ */
+static void put_long(uint8_t *buffer, uint32_t value)
+{
+    buffer[0] = (value >> 24) & 0xFF;
+    buffer[1] = (value >> 16) & 0xFF;
+    buffer[2] = (value >> 8) & 0xFF;
+    buffer[3] = value & 0xFF;
+}
+
+/**
+ * @brief   Statistics Action (Report rendering counters Command)
+ *          Replies with a packet of the same format: STX, CMD_STA, size,
+ *          glyph cache hits, glyph cache misses, window cache saved bytes,
+ *          ETX
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool sta_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_STA);
+
+    uint8_t reply[STA_SIZE + 7];
+
+    reply[0] = CMD_STX;
+    reply[1] = CMD_STA;
+    put_long(&reply[2], STA_SIZE);
+    put_long(&reply[6 + STA_GLYPH_HITS], tft_get_glyph_cache_hits());
+    put_long(&reply[6 + STA_GLYPH_MISSES], tft_get_glyph_cache_misses());
+    put_long(&reply[6 + STA_SAVED_BYTES], tft_get_saved_bytes());
+    reply[6 + STA_SIZE] = CMD_ETX;
+
+    uart_write(uart_type, &reply[0], sizeof(reply));
+
+    return true;
+}
+
+/**
+ * @brief   Terminal Action (Scrolling console Command)
+ *          TRM_START: top(H), top(L), bottom(H), bottom(L), font_size,
+ *                     color(H), color(L), bgcolor(H), bgcolor(L)
+ *          TRM_WRITE: text.... ('\n' ends a line)
+ *          TRM_STOP
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool trm_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_TRM);
+
+    bool last_data = false;
+    uint32_t text_size;
+
+    /* Buffer the param byte */
+    RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+    /* Check whether complete packet is received */
+    if (RingBufUsed(&cmd_info.data_ringbuf_obj) == cmd_info.data_size)
+    {
+        RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], cmd_info.data_size);
+        ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+        /* Console rows are written directly, not recorded */
+        dlist_immediate();
+
+        switch (data[TRM_OP])
+        {
+            case TRM_START:
+                if (cmd_info.data_size >= TRM_START_SIZE)
+                {
+                    tft_terminal_start(
+                        convert_to_word(data[TRM_TOP_HIGH], data[TRM_TOP_LOW]),
+                        convert_to_word(data[TRM_BOTTOM_HIGH],
+                                        data[TRM_BOTTOM_LOW]),
+                        data[TRM_FONT_SIZE],
+                        convert_to_word(data[TRM_COLOR_HIGH],
+                                        data[TRM_COLOR_LOW]),
+                        convert_to_word(data[TRM_BGCOLOR_HIGH],
+                                        data[TRM_BGCOLOR_LOW]));
+                }
+                break;
+
+            case TRM_WRITE:
+                text_size = min(cmd_info.data_size - TRM_TEXT,
+                                sizeof(text) - 1);
+
+                memcpy(&text[0], &data[TRM_TEXT], text_size);
+
+                /* Set Null termination at the last character */
+                text[text_size] = 0;
+
+                tft_terminal_write(&text[0]);
+                break;
+
+            default:
+                tft_terminal_stop();
+                break;
+        }
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   Parse the CHR / SCP REGISTER fields of data[] into chr_info
+ */
+static void parse_region(void)
+{
+    chart_region_t *region = &chr_info.region;
+
+    region->x = convert_to_word(data[CHR_X_HIGH], data[CHR_X_LOW]);
+    region->y = convert_to_word(data[CHR_Y_HIGH], data[CHR_Y_LOW]);
+    region->width = convert_to_word(data[CHR_WIDTH_HIGH],
+                                    data[CHR_WIDTH_LOW]);
+    region->height = convert_to_word(data[CHR_HEIGHT_HIGH],
+                                     data[CHR_HEIGHT_LOW]);
+    region->min_value = (int16_t)convert_to_word(data[CHR_MIN_HIGH],
+                                                 data[CHR_MIN_LOW]);
+    region->max_value = (int16_t)convert_to_word(data[CHR_MAX_HIGH],
+                                                 data[CHR_MAX_LOW]);
+    region->fgcolor = convert_to_word(data[CHR_COLOR_HIGH],
+                                      data[CHR_COLOR_LOW]);
+    region->bgcolor = convert_to_word(data[CHR_BGCOLOR_HIGH],
+                                      data[CHR_BGCOLOR_LOW]);
+}
+
+/**
+ * @brief   Chart Action (Strip-chart Command)
+ *          op, id, then
+ *          CHR_REGISTER: x(H), x(L), y(H), y(L), width(H), width(L),
+ *                        height(H), height(L), min(H), min(L), max(H), max(L),
+ *                        color(H), color(L), bgcolor(H), bgcolor(L)
+ *          CHR_SAMPLE:   value(H)[0], value(L)[0], ... (signed)
+ *          CHR_REMOVE
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool chr_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_CHR);
+
+    bool last_data = false;
+
+    /* Buffer the byte */
+    RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+    /* Fields are parsed straight out of data[], nothing is copied to the
+     * stack (see the RAM budget in setting.h) */
+    if (parse_state == STATE_PARAM)
+    {
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == CHR_PARAM_SIZE)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], CHR_PARAM_SIZE);
+
+            chr_info.op = data[CHR_OP];
+            chr_info.id = data[CHR_ID];
+
+            /* Change to Data State */
+            parse_state = STATE_DATA;
+
+            /* Charts are drawn directly, not recorded */
+            dlist_immediate();
+
+            if (chr_info.op == CHR_REMOVE)
+            {
+                chart_remove(chr_info.id);
+            }
+        }
+    }
+    else if (chr_info.op == CHR_SAMPLE)
+    {
+        /* Each sample is drawn as soon as it is received */
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == 2)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], 2);
+
+            chart_add_sample(chr_info.id,
+                             (int16_t)convert_to_word(data[0], data[1]));
+        }
+    }
+    else if (chr_info.op == CHR_REGISTER)
+    {
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == CHR_REGISTER_SIZE)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0],
+                        CHR_REGISTER_SIZE);
+
+            parse_region();
+
+            chart_register(chr_info.id, &chr_info.region);
+        }
+    }
+
+    /* Check if it's last byte */
+    if (cmd_info.current_data == cmd_info.data_size)
+    {
+        RingBufFlush(&cmd_info.data_ringbuf_obj);
+
+        parse_state = STATE_PARAM;
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   Scope Action (Oscilloscope trace Command)
+ *          op, id, then
+ *          SCP_REGISTER: as CHR_REGISTER (plot rectangle, range, colours)
+ *          SCP_TRACE8:   value[0], value[1], ... (unsigned 8-bit)
+ *          SCP_TRACE16:  value(H)[0], value(L)[0], ... (signed 16-bit)
+ *          SCP_REMOVE
+ *          A trace packet replaces the previous trace of the plot
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool scp_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_SCP);
+
+    bool last_data = false;
+
+    /* Buffer the byte */
+    RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+    /* Fields are parsed straight out of data[] as for chr_action */
+    if (parse_state == STATE_PARAM)
+    {
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == CHR_PARAM_SIZE)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], CHR_PARAM_SIZE);
+
+            chr_info.op = data[CHR_OP];
+            chr_info.id = data[CHR_ID];
+
+            /* Change to Data State */
+            parse_state = STATE_DATA;
+
+            /* Plots are drawn directly, not recorded */
+            dlist_immediate();
+
+            if ((chr_info.op == SCP_TRACE8) || (chr_info.op == SCP_TRACE16))
+            {
+                scope_trace_begin(chr_info.id);
+            }
+            else if (chr_info.op == SCP_REMOVE)
+            {
+                scope_remove(chr_info.id);
+            }
+        }
+    }
+    else if (chr_info.op == SCP_TRACE8)
+    {
+        RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], 1);
+
+        scope_trace_sample(chr_info.id, data[0]);
+    }
+    else if (chr_info.op == SCP_TRACE16)
+    {
+        /* Each sample updates its column as soon as it is received */
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == 2)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], 2);
+
+            scope_trace_sample(chr_info.id,
+                               (int16_t)convert_to_word(data[0], data[1]));
+        }
+    }
+    else if (chr_info.op == SCP_REGISTER)
+    {
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == CHR_REGISTER_SIZE)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0],
+                        CHR_REGISTER_SIZE);
+
+            parse_region();
+
+            scope_register(chr_info.id, &chr_info.region);
+        }
+    }
+
+    /* Check if it's last byte */
+    if (cmd_info.current_data == cmd_info.data_size)
+    {
+        if ((chr_info.op == SCP_TRACE8) || (chr_info.op == SCP_TRACE16))
+        {
+            scope_trace_end(chr_info.id);
+        }
+
+        RingBufFlush(&cmd_info.data_ringbuf_obj);
+
+        parse_state = STATE_PARAM;
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   Field Action (Register numeric field Command)
+ *          id, x(H), x(L), y(H), y(L), font_size, color(H), color(L),
+ *          bgcolor(H), bgcolor(L), width, align
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool fld_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_FLD);
+
+    bool last_data = false;
+
+    /* Buffer the param byte */
+    RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+    /* Check whether complete packet is received */
+    if (RingBufUsed(&cmd_info.data_ringbuf_obj) == cmd_info.data_size)
+    {
+        RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], cmd_info.data_size);
+        ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+        /* Fields are drawn directly, not recorded */
+        dlist_immediate();
+
+        numfield_register(data[FLD_ID],
+                          convert_to_word(data[FLD_X_HIGH], data[FLD_X_LOW]),
+                          convert_to_word(data[FLD_Y_HIGH], data[FLD_Y_LOW]),
+                          data[FLD_FONT_SIZE],
+                          convert_to_word(data[FLD_COLOR_HIGH],
+                                          data[FLD_COLOR_LOW]),
+                          convert_to_word(data[FLD_BGCOLOR_HIGH],
+                                          data[FLD_BGCOLOR_LOW]),
+                          data[FLD_WIDTH],
+                          (data[FLD_ALIGN] != 0) ? NUMFIELD_RIGHT
+                                                 : NUMFIELD_LEFT);
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   Number Action (Update numeric field Command)
+ *          id, value(3), value(2), value(1), value(0)
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool num_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_NUM);
+
+    bool last_data = false;
+    int32_t value;
+
+    /* Buffer the param byte */
+    RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+    /* Check whether complete packet is received */
+    if (RingBufUsed(&cmd_info.data_ringbuf_obj) == cmd_info.data_size)
+    {
+        RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], cmd_info.data_size);
+        ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+        value = (int32_t)((((uint32_t)data[NUM_VALUE]) << 24) |
+                          (((uint32_t)data[NUM_VALUE + 1]) << 16) |
+                          (((uint32_t)data[NUM_VALUE + 2]) << 8) |
+                          ((uint32_t)data[NUM_VALUE + 3]));
+
+        dlist_immediate();
+
+        numfield_set(data[NUM_ID], value);
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   Asset Action (Draw flash asset Command)
+ *          id, x(H), x(L), y(H), y(L)
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool ast_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_AST);
+
+    bool last_data = false;
+
+    /* Buffer the param byte */
+    RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+    /* Check whether complete packet is received */
+    if (RingBufUsed(&cmd_info.data_ringbuf_obj) == cmd_info.data_size)
+    {
+        RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], cmd_info.data_size);
+        ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+        /* Asset is not recorded, draw the frame so far first */
+        dlist_immediate();
+
+        tft_blit_asset(data[AST_ID],
+                       convert_to_word(data[AST_X_HIGH], data[AST_X_LOW]),
+                       convert_to_word(data[AST_Y_HIGH], data[AST_Y_LOW]));
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   Open the window of a compressed image
+ *          x(H), x(L), y(H), y(L), w(H), w(L), h(H), h(L) in data[]
+ */
+static void image_begin(void)
+{
+    uint16_t x, y;
+    uint16_t width, height;
+
+    x = convert_to_word(data[IMAGE_X_HIGH], data[IMAGE_X_LOW]);
+    y = convert_to_word(data[IMAGE_Y_HIGH], data[IMAGE_Y_LOW]);
+    width = convert_to_word(data[IMAGE_WIDTH_HIGH], data[IMAGE_WIDTH_LOW]);
+    height = convert_to_word(data[IMAGE_HEIGHT_HIGH], data[IMAGE_HEIGHT_LOW]);
+
+    /* Change to Image Pixel State */
+    parse_state = STATE_DATA;
+    pixel_chunk_size = 0;
+    pixel_remaining = (uint32_t)width * height;
+
+    /* Image is not recorded, draw the frame so far first */
+    dlist_immediate();
+
+    tft_start_image_transfer(x, y, x + width - 1, y + height - 1);
+}
+
+/**
+ * @brief   Hand the pixels gathered so far to uDMA and fill the other chunk
+ */
+static void image_flush(void)
+{
+    if (pixel_chunk_size > 0)
+    {
+        tft_send_pixels(&pixel_chunk[pixel_chunk_index][0], pixel_chunk_size);
+        pixel_chunk_index ^= 1;
+        pixel_chunk_size = 0;
+    }
+}
+
+/**
+ * @brief   Stream count pixels of one colour into the image window
+ *          Long runs are sent as one burst, pixels beyond the image size
+ *          are dropped
+ * @param   color   Colour (16-bit)
+ * @param   count   Number of pixels
+ */
+static void image_put(uint16_t color, uint32_t count)
+{
+    count = min(count, pixel_remaining);
+    pixel_remaining -= count;
+
+    if (count >= PIXEL_BURST_SIZE)
+    {
+        image_flush();
+        tft_send_color(color, count);
+        return;
+    }
+
+    while (count > 0)
+    {
+        pixel_chunk[pixel_chunk_index][pixel_chunk_size++] = color;
+        count--;
+
+        if (pixel_chunk_size == PIXEL_CHUNK_SIZE)
+        {
+            image_flush();
+        }
+    }
+}
+
+/**
+ * @brief   Close the window of a compressed image if it was opened
+ */
+static void image_end(void)
+{
+    if (parse_state == STATE_DATA)
+    {
+        image_flush();
+        tft_done_transfer();
+    }
+
+    parse_state = STATE_PARAM;
+}
+
+/**
+ * @brief   QOI Action (Draw QOI-style compressed image Command)
+ *          x(H), x(L), y(H), y(L), w(H), w(L), h(H), h(L), QOI data...
+ *          Pixels are decoded as the bytes arrive and streamed into the
+ *          image window (see qoi.c)
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool qoi_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_QOI);
+
+    bool last_data = false;
+    uint16_t color;
+    uint8_t count;
+
+    /* Decode Image Pixel */
+    if (parse_state == STATE_DATA)
+    {
+        count = qoi_decode(byte, &color);
+
+        image_put(color, count);
+    }
+    /* Getting Image Parameter */
+    else
+    {
+        RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == IMAGE_PARAM_SIZE)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], IMAGE_PARAM_SIZE);
+            ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+            qoi_begin();
+
+            image_begin();
+        }
+    }
+
+    /* Check if it's last byte */
+    if (cmd_info.current_data == cmd_info.data_size)
+    {
+        image_end();
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   RLE Action (Draw run-length encoded image Command)
+ *          x(H), x(L), y(H), y(L), w(H), w(L), h(H), h(L), tokens...
+ *          1nnnnnnn c(H) c(L)          n + 1 pixels of colour c
+ *          0nnnnnnn (c(H) c(L)) * n+1  n + 1 pixels as they are
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool rle_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_RLE);
+
+    bool last_data = false;
+
+    /* Decode Image Pixel */
+    if (parse_state == STATE_DATA)
+    {
+        switch (image_info.state)
+        {
+            case IMAGE_TOKEN:
+                image_info.count = (byte & RLE_RUN) ? (byte & ~RLE_RUN) + 1
+                                                    : byte + 1;
+                image_info.state = (byte & RLE_RUN) ? IMAGE_RUN_HIGH
+                                                    : IMAGE_LITERAL_HIGH;
+                break;
+
+            case IMAGE_RUN_HIGH:
+                image_info.high_byte = byte;
+                image_info.state = IMAGE_RUN_LOW;
+                break;
+
+            case IMAGE_RUN_LOW:
+                image_put(convert_to_word(image_info.high_byte, byte),
+                          image_info.count);
+                image_info.state = IMAGE_TOKEN;
+                break;
+
+            case IMAGE_LITERAL_HIGH:
+                image_info.high_byte = byte;
+                image_info.state = IMAGE_LITERAL_LOW;
+                break;
+
+            default:
+                image_put(convert_to_word(image_info.high_byte, byte), 1);
+                image_info.count--;
+                image_info.state = (image_info.count > 0) ? IMAGE_LITERAL_HIGH
+                                                          : IMAGE_TOKEN;
+                break;
+        }
+    }
+    /* Getting Image Parameter */
+    else
+    {
+        RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == IMAGE_PARAM_SIZE)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], IMAGE_PARAM_SIZE);
+            ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+            image_info.state = IMAGE_TOKEN;
+
+            image_begin();
+        }
+    }
+
+    /* Check if it's last byte */
+    if (cmd_info.current_data == cmd_info.data_size)
+    {
+        image_end();
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   Palette Action (Draw palette-indexed image Command)
+ *          x(H), x(L), y(H), y(L), w(H), w(L), h(H), h(L), bpp, entries,
+ *          palette (c(H) c(L)) * entries, indices...
+ *          bpp is 1, 2, 4 or 8 and entries 0 means 256. Indices are
+ *          packed MSB first, every row starts on a new byte
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool pal_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_PAL);
+
+    bool last_data = false;
+    uint8_t mask;
+    int8_t shift;
+
+    /* Decode Image Pixel */
+    if (parse_state == STATE_DATA)
+    {
+        switch (image_info.state)
+        {
+            case IMAGE_LITERAL_HIGH:
+                image_info.high_byte = byte;
+                image_info.state = IMAGE_LITERAL_LOW;
+                break;
+
+            case IMAGE_LITERAL_LOW:
+                palette[image_info.entry++] =
+                    convert_to_word(image_info.high_byte, byte);
+                image_info.state = (image_info.entry < image_info.entries)
+                                       ? IMAGE_LITERAL_HIGH : IMAGE_INDEX;
+                break;
+
+            default:
+                /* Expand the indices through the palette */
+                mask = (1 << image_info.bpp) - 1;
+
+                for (shift = 8 - image_info.bpp;
+                     (shift >= 0) && (image_info.column < image_info.width);
+                     shift -= image_info.bpp)
+                {
+                    image_put(palette[(byte >> shift) & mask], 1);
+                    image_info.column++;
+                }
+
+                /* Rest of the byte is row padding */
+                if (image_info.column == image_info.width)
+                {
+                    image_info.column = 0;
+                }
+                break;
+        }
+    }
+    /* Getting Image Parameter */
+    else
+    {
+        RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == PAL_PARAM_SIZE)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], PAL_PARAM_SIZE);
+            ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+            image_info.bpp = data[PAL_BPP];
+            image_info.entries = (data[PAL_ENTRIES] == 0) ? PALETTE_SIZE
+                                                          : data[PAL_ENTRIES];
+            image_info.entry = 0;
+            image_info.width = convert_to_word(data[IMAGE_WIDTH_HIGH],
+                                               data[IMAGE_WIDTH_LOW]);
+            image_info.column = 0;
+            image_info.state = IMAGE_LITERAL_HIGH;
+
+            ASSERT((image_info.bpp == 1) || (image_info.bpp == 2) ||
+                   (image_info.bpp == 4) || (image_info.bpp == 8));
+
+            /* Unsupported depth, take the indices as 8 bpp */
+            if ((image_info.bpp != 1) && (image_info.bpp != 2) &&
+                (image_info.bpp != 4))
+            {
+                image_info.bpp = 8;
+            }
+
+            /* Unused entries are black */
+            memset(&palette[0], 0, sizeof(palette));
+
+            image_begin();
+        }
+    }
+
+    /* Check if it's last byte */
+    if (cmd_info.current_data == cmd_info.data_size)
+    {
+        image_end();
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   Mask Action (Draw 1-bpp mask Command)
+ *          x(H), x(L), y(H), y(L), w(H), w(L), h(H), h(L), color(H),
+ *          color(L), bgcolor(H), bgcolor(L), flags, rows...
+ *          Rows are packed MSB first, every row starts on a new byte.
+ *          Each row is drawn once complete (see tft_draw_mask_row), the
+ *          rows of a mask that cannot be drawn are skipped
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool msk_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_MSK);
+
+    bool last_data = false;
+    uint16_t x, y;
+    uint16_t width, height;
+
+    /* Mask Row (rows of a rejected mask are skipped) */
+    if (parse_state == STATE_DATA)
+    {
+        if (!parse_discard)
+        {
+            data[mask_info.received++] = byte;
+
+            if (mask_info.received == mask_info.stride)
+            {
+                tft_draw_mask_row(mask_info.x0, mask_info.y0,
+                                  mask_info.x1, mask_info.y1,
+                                  mask_info.row, &data[0],
+                                  mask_info.fgcolor, mask_info.bgcolor,
+                                  mask_info.transparent);
+
+                mask_info.row++;
+                mask_info.received = 0;
+            }
+        }
+    }
+    /* Getting Mask Parameter */
+    else
+    {
+        RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == MSK_PARAM_SIZE)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], MSK_PARAM_SIZE);
+            ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+            x = convert_to_word(data[IMAGE_X_HIGH], data[IMAGE_X_LOW]);
+            y = convert_to_word(data[IMAGE_Y_HIGH], data[IMAGE_Y_LOW]);
+            width = convert_to_word(data[IMAGE_WIDTH_HIGH], data[IMAGE_WIDTH_LOW]);
+            height = convert_to_word(data[IMAGE_HEIGHT_HIGH], data[IMAGE_HEIGHT_LOW]);
+
+            mask_info.x0 = x;
+            mask_info.y0 = y;
+            mask_info.x1 = x + width - 1;
+            mask_info.y1 = y + height - 1;
+            mask_info.fgcolor = convert_to_word(data[MSK_COLOR_HIGH],
+                                                data[MSK_COLOR_LOW]);
+            mask_info.bgcolor = convert_to_word(data[MSK_BGCOLOR_HIGH],
+                                                data[MSK_BGCOLOR_LOW]);
+            mask_info.transparent = (data[MSK_FLAGS] & MSK_TRANSPARENT) != 0;
+            mask_info.stride = (width + 7) / 8;
+            mask_info.row = 0;
+            mask_info.received = 0;
+
+            /* Empty masks and rows wider than the buffer are not drawn */
+            parse_discard = (width == 0) || (height == 0) ||
+                            (mask_info.stride > MSG_SIZE);
+            parse_state = STATE_DATA;
+
+            if (!parse_discard)
+            {
+                /* Mask is not recorded, draw the frame so far first */
+                dlist_immediate();
+            }
+        }
+    }
+
+    /* Check if it's last byte */
+    if (cmd_info.current_data == cmd_info.data_size)
+    {
+        parse_state = STATE_PARAM;
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   JPG Action (Draw baseline JPEG image Command)
+ *          x(H), x(L), y(H), y(L), JPEG file...
+ *          MCUs are decoded and drawn as the bytes arrive (see jpeg.c).
+ *          An unsupported or corrupt file stops drawing, the rest of the
+ *          packet is consumed
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool jpg_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_JPG);
+
+    bool last_data = false;
+
+    /* Decode JPEG File */
+    if (parse_state == STATE_DATA)
+    {
+        jpeg_feed(byte);
+    }
+    /* Getting JPEG Parameter */
+    else
+    {
+        RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == JPG_PARAM_SIZE)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], JPG_PARAM_SIZE);
+            ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+            parse_state = STATE_DATA;
+
+            /* Image is not recorded, draw the frame so far first */
+            dlist_immediate();
+
+            jpeg_begin(convert_to_word(data[JPG_X_HIGH], data[JPG_X_LOW]),
+                       convert_to_word(data[JPG_Y_HIGH], data[JPG_Y_LOW]));
+        }
+    }
+
+    /* Check if it's last byte */
+    if (cmd_info.current_data == cmd_info.data_size)
+    {
+        if (parse_state == STATE_DATA)
+        {
+            jpeg_end();
+        }
+
+        parse_state = STATE_PARAM;
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   TIL Action (Load tile set Command)
+ *          size, bpp, first, (palette (H), (L) * 16 if bpp is 4), tiles...
+ *          Tiles are stored as the bytes arrive (see tilemap.c)
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool til_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_TIL);
+
+    bool last_data = false;
+
+    /* Load Tile Data (tiles of a rejected set are skipped) */
+    if (parse_state == STATE_DATA)
+    {
+        if (!parse_discard)
+        {
+            tilemap_load(byte);
+        }
+    }
+    /* Getting Tile Set Parameter */
+    else
+    {
+        RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == TIL_PARAM_SIZE)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], TIL_PARAM_SIZE);
+            ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+            /* Unsupported tile format is not loaded */
+            parse_discard = !tilemap_load_begin(data[TIL_SIZE], data[TIL_BPP],
+                                                data[TIL_FIRST]);
+            parse_state = STATE_DATA;
+        }
+    }
+
+    /* Check if it's last byte */
+    if (cmd_info.current_data == cmd_info.data_size)
+    {
+        parse_state = STATE_PARAM;
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   MAP Action (Draw tile map Command)
+ *          x(H), x(L), y(H), y(L), cols, rows, tile index * cols * rows
+ *          Every map row is drawn in one window once complete
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool map_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_MAP);
+
+    bool last_data = false;
+
+    /* Map Cell (cells of a rejected map are skipped) */
+    if (parse_state == STATE_DATA)
+    {
+        if (!parse_discard)
+        {
+            tilemap_map(byte);
+        }
+    }
+    /* Getting Map Parameter */
+    else
+    {
+        RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == MAP_PARAM_SIZE)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], MAP_PARAM_SIZE);
+            ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+            /* Map is not recorded, draw the frame so far first */
+            dlist_immediate();
+
+            /* Map that cannot be placed is not drawn */
+            parse_discard =
+                !tilemap_place(convert_to_word(data[MAP_X_HIGH], data[MAP_X_LOW]),
+                               convert_to_word(data[MAP_Y_HIGH], data[MAP_Y_LOW]),
+                               data[MAP_COLS], data[MAP_ROWS]);
+            parse_state = STATE_DATA;
+        }
+    }
+
+    /* Check if it's last byte */
+    if (cmd_info.current_data == cmd_info.data_size)
+    {
+        parse_state = STATE_PARAM;
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   CEL Action (Change tile map cells Command)
+ *          (col, row, tile index) * n
+ *          Only cells whose tile changed are drawn
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool cel_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_CEL);
+
+    bool last_data = false;
+
+    /* Buffer the cell byte */
+    RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+    if (RingBufUsed(&cmd_info.data_ringbuf_obj) == CEL_SIZE)
+    {
+        RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], CEL_SIZE);
+        ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+        dlist_immediate();
+
+        tilemap_set_cell(data[CEL_COL], data[CEL_ROW], data[CEL_TILE]);
+    }
+
+    /* Check if it's last byte */
+    if (cmd_info.current_data == cmd_info.data_size)
+    {
+        /* Drop a trailing partial cell */
+        RingBufFlush(&cmd_info.data_ringbuf_obj);
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   ATL Action (Load sprite atlas Command)
+ *          w(H), w(L), h(H), h(L), bpp, (palette (H), (L) * 16 if bpp
+ *          is 4), atlas...
+ *          The atlas is stored as the bytes arrive (see sprite.c)
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool atl_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_ATL);
+
+    bool last_data = false;
+
+    /* Load Atlas Data (pixels of a rejected atlas are skipped) */
+    if (parse_state == STATE_DATA)
+    {
+        if (!parse_discard)
+        {
+            sprite_load(byte);
+        }
+    }
+    /* Getting Atlas Parameter */
+    else
+    {
+        RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+        if (RingBufUsed(&cmd_info.data_ringbuf_obj) == ATL_PARAM_SIZE)
+        {
+            RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], ATL_PARAM_SIZE);
+            ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+            /* Atlas that does not fit is not loaded */
+            parse_discard =
+                !sprite_load_begin(convert_to_word(data[ATL_WIDTH_HIGH],
+                                                   data[ATL_WIDTH_LOW]),
+                                   convert_to_word(data[ATL_HEIGHT_HIGH],
+                                                   data[ATL_HEIGHT_LOW]),
+                                   data[ATL_BPP]);
+            parse_state = STATE_DATA;
+        }
+    }
+
+    /* Check if it's last byte */
+    if (cmd_info.current_data == cmd_info.data_size)
+    {
+        parse_state = STATE_PARAM;
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   Parse the SPR fields of data[] into sprite_params
+ */
+static void parse_sprite(void)
+{
+    sprite_params_t *params = &sprite_params;
+
+    params->sx = convert_to_word(data[SPR_SX_HIGH], data[SPR_SX_LOW]);
+    params->sy = convert_to_word(data[SPR_SY_HIGH], data[SPR_SY_LOW]);
+    params->width = data[SPR_WIDTH];
+    params->height = data[SPR_HEIGHT];
+    params->x = convert_to_word(data[SPR_X_HIGH], data[SPR_X_LOW]);
+    params->y = convert_to_word(data[SPR_Y_HIGH], data[SPR_Y_LOW]);
+    params->z = data[SPR_Z];
+    params->bgcolor = convert_to_word(data[SPR_BGCOLOR_HIGH],
+                                      data[SPR_BGCOLOR_LOW]);
+    params->tile_bg = (data[SPR_FLAGS] & SPR_TILE_BG) != 0;
+    params->visible = (data[SPR_FLAGS] & SPR_VISIBLE) != 0;
+}
+
+/**
+ * @brief   SPR Action (Set sprite Command)
+ *          id, sx(H), sx(L), sy(H), sy(L), w, h, x(H), x(L), y(H), y(L),
+ *          z, flags, bgcolor(H), bgcolor(L)
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool spr_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_SPR);
+
+    bool last_data = false;
+
+    /* Buffer the param byte */
+    RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+    /* Check whether complete packet is received */
+    if (RingBufUsed(&cmd_info.data_ringbuf_obj) == cmd_info.data_size)
+    {
+        RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], cmd_info.data_size);
+        ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+        dlist_immediate();
+
+        parse_sprite();
+
+        sprite_set(data[SPR_ID], &sprite_params);
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
+/**
+ * @brief   MOV Action (Move sprites Command)
+ *          (id, x(H), x(L), y(H), y(L)) * n
+ *          Each sprite repaints only its old and new boxes
+ * @param   byte    received byte
+ * @return  True if the received byte is the last data byte
+ */
+static bool mov_action(uint8_t byte)
+{
+    ASSERT(cmd_info.cmd.name == CMD_MOV);
+
+    bool last_data = false;
+
+    /* Buffer the move byte */
+    RingBufWrite(&cmd_info.data_ringbuf_obj, &byte, 1);
+
+    if (RingBufUsed(&cmd_info.data_ringbuf_obj) == MOV_SIZE)
+    {
+        RingBufRead(&cmd_info.data_ringbuf_obj, &data[0], MOV_SIZE);
+        ASSERT(RingBufEmpty(&cmd_info.data_ringbuf_obj));
+
+        dlist_immediate();
+
+        sprite_move(data[MOV_ID],
+                    convert_to_word(data[MOV_X_HIGH], data[MOV_X_LOW]),
+                    convert_to_word(data[MOV_Y_HIGH], data[MOV_Y_LOW]));
+    }
+
+    /* Check if it's last byte */
+    if (cmd_info.current_data == cmd_info.data_size)
+    {
+        /* Drop a trailing partial move */
+        RingBufFlush(&cmd_info.data_ringbuf_obj);
+
+        last_data = true;
+    }
+
+    return last_data;
+}
+
 /**
  * @brief   Process Command Parser by invoking state table based on current
  *          parser state
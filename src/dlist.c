@@ -0,0 +1,321 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  dlist.c
+ *
+ *    Description:  Display list (deferred drawing of a frame) implementation
+ *                  Between dlist_begin and dlist_end, primitives are
+ *                  recorded into a bounded RAM list instead of being drawn.
+ *                  dlist_end rasterises the list band by band, so every
+ *                  panel pixel is written exactly once per frame.
+ *                  If the list overflows, or a command cannot be deferred,
+ *                  the recorded part is drawn and the rest of the frame is
+ *                  drawn immediately.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 03:20:44 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "dlist.h"
+#include "band.h"
+#include "tft.h"
+#include "setting.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* Screen background of a frame */
+#define DLIST_BACKGROUND    BLACK
+
+/* Record size: op, x0, y0, x1, y1, color */
+#define FILL_RECORD_SIZE    (11U)
+
+/* Record size without text: op, x, y, size, color, text length */
+#define TEXT_RECORD_SIZE    (8U)
+
+/* Longest text recorded */
+#define TEXT_MAX_LENGTH     (255U)
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+/* Record operation */
+typedef enum
+{
+    DLIST_FILL = 0,
+    DLIST_TEXT
+} dlist_op_t;
+
+typedef struct
+{
+    /* Records (op byte followed by big-endian parameters) */
+    uint8_t  list[DLIST_SIZE];
+
+    /* Bytes used in list */
+    uint32_t used;
+
+    /* Frame is open */
+    bool     frame;
+
+    /* Primitives are recorded (frame is open and has not fallen back) */
+    bool     recording;
+} dlist_info_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static dlist_info_t dlist_info;
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Append a word (MSB first) to the list
+ * @param   word    Word
+ */
+static void put_word(uint16_t word)
+{
+    dlist_info.list[dlist_info.used++] = word >> 8;
+    dlist_info.list[dlist_info.used++] = word & 0xff;
+}
+
+/**
+ * @brief   Read a word (MSB first) from a record
+ * @param   record  Record position
+ * @return  Word
+ */
+static uint16_t get_word(const uint8_t *record)
+{
+    return convert_to_word(record[0], record[1]);
+}
+
+/**
+ * @brief   Check whether a record fits; draw the recorded part and fall back
+ *          to immediate mode if it does not
+ * @param   size    Record size
+ * @return  True if the record is to be recorded
+ */
+static bool reserve(uint32_t size)
+{
+    if (dlist_info.recording && (dlist_info.used + size > DLIST_SIZE))
+    {
+        dlist_immediate();
+    }
+
+    return dlist_info.recording;
+}
+
+/**
+ * @brief   Draw every record of the list into the current band
+ */
+static void replay(void)
+{
+    const uint8_t *record = &dlist_info.list[0];
+    const uint8_t *end = &dlist_info.list[dlist_info.used];
+
+    while (record < end)
+    {
+        switch ((dlist_op_t)record[0])
+        {
+            case DLIST_FILL:
+                band_fill_area(get_word(&record[1]), get_word(&record[3]),
+                               get_word(&record[5]), get_word(&record[7]),
+                               get_word(&record[9]));
+                record += FILL_RECORD_SIZE;
+                break;
+
+            case DLIST_TEXT:
+                /* Text is stored NULL terminated after the record */
+                band_draw_string_only((char *)&record[TEXT_RECORD_SIZE],
+                                      get_word(&record[1]),
+                                      get_word(&record[3]),
+                                      record[5],
+                                      get_word(&record[6]));
+                record += TEXT_RECORD_SIZE + record[7] + 1;
+                break;
+
+            default:
+                ASSERT(false);
+                record = end;
+                break;
+        }
+    }
+}
+
+/**
+ * @brief   Rasterise the recorded list to the whole screen
+ */
+static void render(void)
+{
+    band_render(replay, DLIST_BACKGROUND);
+
+    dlist_info.used = 0;
+}
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Begin a frame, following primitives are recorded
+ *          An open frame is ended first
+ */
+void dlist_begin(void)
+{
+    if (dlist_info.frame)
+    {
+        dlist_end();
+    }
+
+    dlist_info.used = 0;
+    dlist_info.frame = true;
+    dlist_info.recording = true;
+}
+
+/**
+ * @brief   End a frame and draw the recorded primitives
+ *          The frame covers the whole screen: pixels not drawn by any
+ *          primitive are set to the background colour
+ */
+void dlist_end(void)
+{
+    if (dlist_info.recording)
+    {
+        render();
+    }
+
+    dlist_info.frame = false;
+    dlist_info.recording = false;
+}
+
+/**
+ * @brief   Draw the recorded primitives now and draw the rest of the frame
+ *          immediately (for commands that cannot be recorded)
+ */
+void dlist_immediate(void)
+{
+    if (dlist_info.recording)
+    {
+        render();
+
+        dlist_info.recording = false;
+    }
+}
+
+/**
+ * @brief   Check whether primitives are being recorded
+ * @return  True if recording
+ */
+bool dlist_recording(void)
+{
+    return dlist_info.recording;
+}
+
+/**
+ * @brief   Fill area (x0, y0) to (x1, y1) with colour (see tft_fill_area)
+ * @param   x0    Top left x coordinate
+ * @param   y0    Top left y coordinate
+ * @param   x1    Bottom right x coordinate
+ * @param   y1    Bottom right y coordinate
+ * @param   color Colour (16-bit)
+ */
+void dlist_fill_area(uint16_t x0, uint16_t y0,
+                     uint16_t x1, uint16_t y1,
+                     uint16_t color)
+{
+    if (reserve(FILL_RECORD_SIZE))
+    {
+        dlist_info.list[dlist_info.used++] = DLIST_FILL;
+        put_word(x0);
+        put_word(y0);
+        put_word(x1);
+        put_word(y1);
+        put_word(color);
+    }
+    else
+    {
+        tft_fill_area(x0, y0, x1, y1, color);
+    }
+}
+
+/**
+ * @brief   Clear screen to all black
+ *          Within a frame, everything recorded so far is hidden and dropped
+ */
+void dlist_clear_screen(void)
+{
+    if (dlist_info.recording)
+    {
+        dlist_info.used = 0;
+    }
+    else
+    {
+        tft_clear_screen();
+    }
+}
+
+/**
+* @brief    Draw string at (x,y) without background colour
+*           (see tft_draw_string_only)
+* @param    string    String input. Eg: "abc"
+* @param    x         x coordinate
+* @param    y         y coordinate
+* @param    size      font size
+* @param    color     color
+*/
+void dlist_draw_string_only(char *string, uint16_t x, uint16_t y,
+                            uint16_t size, uint16_t color)
+{
+    uint32_t length = strlen(string);
+
+    if ((length <= TEXT_MAX_LENGTH) &&
+        (size <= 0xff) &&
+        reserve(TEXT_RECORD_SIZE + length + 1))
+    {
+        dlist_info.list[dlist_info.used++] = DLIST_TEXT;
+        put_word(x);
+        put_word(y);
+        dlist_info.list[dlist_info.used++] = size;
+        put_word(color);
+        dlist_info.list[dlist_info.used++] = length;
+
+        memcpy(&dlist_info.list[dlist_info.used], string, length + 1);
+        dlist_info.used += length + 1;
+    }
+    else
+    {
+        /* Keep drawing order with the primitives recorded before */
+        dlist_immediate();
+
+        tft_draw_string_only(string, x, y, size, color);
+    }
+}
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Display list initialisation
+ */
+void dlist_init(void)
+{
+    dlist_info.used = 0;
+    dlist_info.frame = false;
+    dlist_info.recording = false;
+}
@@ -0,0 +1,52 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  dlist.h
+ *
+ *    Description:  Display list (deferred drawing of a frame) header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 03:20:44 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef DLIST_H
+#define DLIST_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+void dlist_begin(void);
+void dlist_end(void);
+void dlist_immediate(void);
+bool dlist_recording(void);
+void dlist_fill_area(uint16_t x0, uint16_t y0,
+                     uint16_t x1, uint16_t y1,
+                     uint16_t color);
+void dlist_clear_screen(void);
+void dlist_draw_string_only(char *string, uint16_t x, uint16_t y,
+                            uint16_t size, uint16_t color);
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+void dlist_init(void);
+
+#endif
@@ -0,0 +1,215 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  dma.c
+ *
+ *    Description:  uDMA transfer engine implementation file
+ *                  Splits a transfer into DMA_MAX_TRANSFER chunks and keeps
+ *                  the primary and alternate control structures loaded in
+ *                  ping-pong mode so the peripheral never waits for the CPU
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 09:12:40 AM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "dma.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+/* Transfer job */
+typedef struct
+{
+    /* Hardware channel */
+    const dma_hal_t *hal;
+
+    /* Next source address to be loaded */
+    const uint8_t   *src;
+
+    /* Items not loaded into a control structure yet */
+    uint32_t        remaining;
+
+    /* Items loaded per control structure (0 = idle) */
+    uint32_t        loaded[DMA_SELECT_COUNT];
+
+    /* Item size in bytes */
+    uint8_t         item_size;
+
+    /* Source address increment */
+    bool            src_increment;
+
+    /* Shared between ISR and non-ISR context. */
+    volatile bool   busy;
+
+} dma_job_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static dma_job_t dma_job;
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Load the next chunk into a control structure
+ * @param   select  Control structure
+ * @return  True if a chunk was loaded
+ */
+static bool load_chunk(dma_select_t select)
+{
+    uint32_t count = dma_chunk_size(dma_job.remaining);
+
+    dma_job.loaded[select] = count;
+
+    if (count > 0)
+    {
+        dma_job.hal->transfer_set(select, dma_job.src, count);
+
+        if (dma_job.src_increment)
+        {
+            dma_job.src += count * dma_job.item_size;
+        }
+
+        dma_job.remaining -= count;
+    }
+
+    return (count > 0);
+}
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Number of items for the next chunk
+ * @param   remaining   Items left in the job
+ * @return  Chunk size (0 when nothing is left)
+ */
+uint32_t dma_chunk_size(uint32_t remaining)
+{
+    return min(remaining, DMA_MAX_TRANSFER);
+}
+
+/**
+ * @brief   Start a transfer on the opened channel (Non-Blocking)
+ *          Source must stay valid until dma_busy returns false
+ * @param   src             Source address
+ * @param   count           Number of items
+ * @param   item_size       Item size (1 or 2 bytes)
+ * @param   src_increment   False to send the same item count times
+ */
+void dma_start(const void *src,
+               uint32_t   count,
+               uint8_t    item_size,
+               bool       src_increment)
+{
+    ASSERT(dma_job.hal != NULL);
+    ASSERT(dma_job.busy == false);
+    ASSERT(src != NULL);
+    ASSERT(count > 0);
+    ASSERT((item_size == 1) || (item_size == 2));
+
+    dma_job.src = (const uint8_t *)src;
+    dma_job.remaining = count;
+    dma_job.item_size = item_size;
+    dma_job.src_increment = src_increment;
+    dma_job.busy = true;
+
+    dma_job.hal->setup(item_size, src_increment);
+
+    /* Primary runs first, alternate is queued behind it */
+    load_chunk(DMA_PRIMARY);
+    load_chunk(DMA_ALTERNATE);
+
+    dma_job.hal->enable();
+}
+
+/**
+ * @brief   Refill completed control structures (Called from ISR)
+ * @return  True when the whole job has completed
+ */
+bool dma_service(void)
+{
+    bool done = false;
+    uint8_t select;
+
+    if (dma_job.busy)
+    {
+        for (select = DMA_PRIMARY; select < DMA_SELECT_COUNT; select++)
+        {
+            if ((dma_job.loaded[select] > 0) &&
+                dma_job.hal->is_done((dma_select_t)select))
+            {
+                load_chunk((dma_select_t)select);
+            }
+        }
+
+        if ((dma_job.loaded[DMA_PRIMARY] == 0) &&
+            (dma_job.loaded[DMA_ALTERNATE] == 0))
+        {
+            dma_job.hal->disable();
+            dma_job.busy = false;
+            done = true;
+        }
+    }
+
+    return done;
+}
+
+/**
+ * @brief   Check whether a transfer is in progress
+ * @return  True if busy
+ */
+bool dma_busy(void)
+{
+    return dma_job.busy;
+}
+
+/**
+ * @brief   Attach the engine to a uDMA channel
+ * @param   hal     Channel hardware abstraction
+ */
+void dma_open(const dma_hal_t *hal)
+{
+    ASSERT(hal != NULL);
+
+    dma_job.hal = hal;
+
+    hal->init();
+}
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   uDMA engine initialisation
+ */
+void dma_init(void)
+{
+    dma_job.hal = NULL;
+    dma_job.src = NULL;
+    dma_job.remaining = 0;
+    dma_job.loaded[DMA_PRIMARY] = 0;
+    dma_job.loaded[DMA_ALTERNATE] = 0;
+    dma_job.busy = false;
+}
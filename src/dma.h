@@ -0,0 +1,105 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  dma.h
+ *
+ *    Description:  uDMA transfer engine header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 09:12:40 AM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef DMA_H
+#define DMA_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+
+/*-----------------------------------------------------------------------------
+ *  Constants
+ *-----------------------------------------------------------------------------*/
+
+/* Maximum number of items in one uDMA transfer */
+#define DMA_MAX_TRANSFER    (1024U)
+
+/*-----------------------------------------------------------------------------
+ *  Types
+ *-----------------------------------------------------------------------------*/
+
+/* uDMA channel control structure */
+typedef enum
+{
+    DMA_PRIMARY = 0,
+    DMA_ALTERNATE,
+    DMA_SELECT_COUNT
+} dma_select_t;
+
+/*
+ * Hardware abstraction of one uDMA channel
+ * The engine only talks to the channel through this table so the chunking
+ * can be run against a host model
+ */
+typedef struct
+{
+    /* Power up the controller and set up the control table */
+    void (*init)(void);
+
+    /* Set item size (1 or 2 bytes) and source increment of both structures */
+    void (*setup)(uint8_t item_size, bool src_increment);
+
+    /* Program one control structure for a ping-pong transfer */
+    void (*transfer_set)(dma_select_t select,
+                         const void   *src,
+                         uint32_t     count);
+
+    /* Return true when the control structure has no transfer left */
+    bool (*is_done)(dma_select_t select);
+
+    /* Enable the channel */
+    void (*enable)(void);
+
+    /* Disable the channel */
+    void (*disable)(void);
+
+} dma_hal_t;
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+uint32_t dma_chunk_size(uint32_t remaining);
+
+void dma_start(const void *src,
+               uint32_t   count,
+               uint8_t    item_size,
+               bool       src_increment);
+
+bool dma_service(void);
+
+bool dma_busy(void);
+
+void dma_open(const dma_hal_t *hal);
+
+/* uDMA channel of SSI0 TX (dma_hal.c) */
+extern const dma_hal_t dma_hal_ssi0_tx;
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+void dma_init(void);
+
+#endif
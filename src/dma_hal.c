@@ -0,0 +1,151 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  dma_hal.c
+ *
+ *    Description:  uDMA channel hardware abstraction (LM4F120 uDMA controller)
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 09:12:40 AM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "dma.h"
+
+/* Third party libraries include */
+#include "inc/hw_ssi.h"
+#include "driverlib/udma.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* uDMA channel used by SSI0 TX */
+#define SSI0_TX_CHANNEL     UDMA_CHANNEL_SSI0TX
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+/* uDMA control table (must be 1024-byte aligned) */
+static uint8_t dma_control_table[1024] __attribute__ ((aligned(1024)));
+
+/* Control structure select map */
+static const uint32_t dma_select_map[DMA_SELECT_COUNT] =
+{
+    UDMA_PRI_SELECT,
+    UDMA_ALT_SELECT
+};
+
+/*-----------------------------------------------------------------------------
+ *  SSI0 TX channel
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Enable uDMA controller and assign the control table
+ */
+static void ssi0_tx_init(void)
+{
+    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    ROM_uDMAEnable();
+    ROM_uDMAControlBaseSet(&dma_control_table[0]);
+
+    ROM_uDMAChannelAttributeDisable(SSI0_TX_CHANNEL,
+                                    UDMA_ATTR_ALTSELECT |
+                                    UDMA_ATTR_HIGH_PRIORITY |
+                                    UDMA_ATTR_REQMASK);
+
+    /* SSI requests a burst when TX FIFO is half empty */
+    ROM_uDMAChannelAttributeEnable(SSI0_TX_CHANNEL, UDMA_ATTR_USEBURST);
+}
+
+/**
+ * @brief   Set item size and source increment of both control structures
+ * @param   item_size       Item size (1 or 2 bytes)
+ * @param   src_increment   Increment source address per item
+ */
+static void ssi0_tx_setup(uint8_t item_size, bool src_increment)
+{
+    uint32_t control;
+
+    if (item_size == 2)
+    {
+        control = UDMA_SIZE_16 |
+                  (src_increment ? UDMA_SRC_INC_16 : UDMA_SRC_INC_NONE);
+    }
+    else
+    {
+        control = UDMA_SIZE_8 |
+                  (src_increment ? UDMA_SRC_INC_8 : UDMA_SRC_INC_NONE);
+    }
+
+    control |= UDMA_DST_INC_NONE | UDMA_ARB_4;
+
+    ROM_uDMAChannelControlSet(SSI0_TX_CHANNEL | UDMA_PRI_SELECT, control);
+    ROM_uDMAChannelControlSet(SSI0_TX_CHANNEL | UDMA_ALT_SELECT, control);
+}
+
+/**
+ * @brief   Program one control structure (ping-pong mode)
+ * @param   select  Control structure
+ * @param   src     Source address
+ * @param   count   Number of items (1 - DMA_MAX_TRANSFER)
+ */
+static void ssi0_tx_transfer_set(dma_select_t select,
+                                 const void   *src,
+                                 uint32_t     count)
+{
+    ROM_uDMAChannelTransferSet(SSI0_TX_CHANNEL | dma_select_map[select],
+                               UDMA_MODE_PINGPONG,
+                               (void *)src,
+                               (void *)(SSI0_BASE + SSI_O_DR),
+                               count);
+}
+
+/**
+ * @brief   Check whether a control structure has completed
+ * @param   select  Control structure
+ * @return  True if stopped
+ */
+static bool ssi0_tx_is_done(dma_select_t select)
+{
+    return (ROM_uDMAChannelModeGet(SSI0_TX_CHANNEL | dma_select_map[select])
+            == UDMA_MODE_STOP);
+}
+
+/**
+ * @brief   Enable SSI0 TX channel
+ */
+static void ssi0_tx_enable(void)
+{
+    ROM_uDMAChannelEnable(SSI0_TX_CHANNEL);
+}
+
+/**
+ * @brief   Disable SSI0 TX channel
+ */
+static void ssi0_tx_disable(void)
+{
+    ROM_uDMAChannelDisable(SSI0_TX_CHANNEL);
+}
+
+/* SSI0 TX channel table */
+const dma_hal_t dma_hal_ssi0_tx =
+{
+    ssi0_tx_init,
+    ssi0_tx_setup,
+    ssi0_tx_transfer_set,
+    ssi0_tx_is_done,
+    ssi0_tx_enable,
+    ssi0_tx_disable
+};
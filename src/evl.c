@@ -32,7 +32,9 @@
 /* Constants                                                                 */
 /*---------------------------------------------------------------------------*/
 
-#define MAX_EVENT (256u)
+/* Callback handles, handle 0 is not used (the SPI transmit callback is the
+ * only user) */
+#define MAX_EVENT (16u)
 
 /*---------------------------------------------------------------------------*/
 /* Private types                                                             */
@@ -174,23 +176,32 @@ static evt_t* pop_queue(void)
 /*---------------------------------------------------------------------------*/
 
 /*
- * Starts the main event loop of the software. 
+ * Services one scheduled event, if any, and returns. Used by a main loop
+ * that runs other tasks in turn.
  */
-static void evl_run(void)
+static void evl_poll(void)
 {
     const evt_t* evl;
 
-    do
+    IntMasterDisable();
+    evl = pop_queue();
+    IntMasterEnable();
+
+    if (evl != NULL)
     {
-        IntMasterDisable();
-        evl = pop_queue();
-        IntMasterEnable();
+        /* Invoke event loop callback */
+        evl->evl_cb(evl->index);
+    }
+}
 
-        if (evl != NULL)
-        {
-            /* Invoke event loop callback */
-            evl->evl_cb(evl->index);
-        }
+/*
+ * Starts the main event loop of the software. 
+ */
+static void evl_run(void)
+{
+    do
+    {
+        evl_poll();
 
     } while (!terminate);
 }
@@ -304,6 +315,7 @@ void evl_init(evl_services_t*   evl_services)
     uint32_t i;
 
     evl_services->run = evl_run;
+    evl_services->poll = evl_poll;
     evl_services->cb_alloc = evl_cb_alloc;
     evl_services->schedule = evl_schedule;
     evl_services->cancel = evl_cancel;
@@ -53,6 +53,9 @@ typedef struct
     /* Start the main loop of the software. */
     void (*run)(void);
 
+    /* Service one scheduled event, if any, and return. */
+    void (*poll)(void);
+
     /* Allocate a callback handle. */
     evl_cb_handle_t (*cb_alloc)(evl_cb_t evl_cb,
                                 uint8_t index);
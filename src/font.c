@@ -0,0 +1,300 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  font.c
+ *
+ *    Description:  Proportional and anti-aliased font implementation file
+ *                  Fonts are compiled by fontgen.py into packed glyph tables
+ *                  (font_tables.h). A glyph cell is as wide as the glyph
+ *                  advance and as high as the font, and is streamed in one
+ *                  window: pixel levels are blended from the background to
+ *                  the foreground colour through a small palette.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 07:02:51 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "font.h"
+#include "tft.h"
+#include "font_tables.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* Blend levels of the deepest font (4 bpp) */
+#define FONT_MAX_LEVELS     (16U)
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    /* Colour of each pixel level, background to foreground */
+    uint16_t palette[FONT_MAX_LEVELS];
+
+    /* Line buffer to be filled next */
+    uint8_t  line_index;
+} font_info_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static font_info_t font_info;
+
+/* Glyph rows, one is filled while uDMA may still send the other */
+static uint16_t font_line[2][FONT_TABLE_MAX_ADVANCE];
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Font of a font ID
+ * @param   font_id     Font ID (1 - FONT_TABLE_COUNT)
+ * @return  Font
+ */
+static const font_t *get_font(uint8_t font_id)
+{
+    ASSERT(font_valid(font_id));
+
+    return &font_table[font_id - 1];
+}
+
+/**
+ * @brief   Glyph of a character, '?' if the font has none
+ * @param   font    Font
+ * @param   ascii   Character
+ * @return  Glyph
+ */
+static const font_glyph_t *get_glyph(const font_t *font, uint8_t ascii)
+{
+    if ((ascii < FONT_TABLE_FIRST) || (ascii > FONT_TABLE_LAST))
+    {
+        ascii = '?';
+    }
+
+    return &font->glyphs[ascii - FONT_TABLE_FIRST];
+}
+
+/**
+ * @brief   Pixel level of a glyph
+ * @param   font    Font
+ * @param   glyph   Glyph
+ * @param   col     Column within the glyph box
+ * @param   row     Row within the glyph box
+ * @return  Level (0 - 2^bpp - 1)
+ */
+static uint8_t glyph_level(const font_t *font, const font_glyph_t *glyph,
+                           uint16_t col, uint16_t row)
+{
+    uint32_t bit = ((uint32_t)row * glyph->width + col) * font->bpp;
+    uint8_t  byte = font->bitmap[glyph->offset + (bit >> 3)];
+
+    /* 1, 2 and 4 bpp pixels never cross a byte */
+    return (byte >> (8 - font->bpp - (bit & 0x07))) & ((1 << font->bpp) - 1);
+}
+
+/**
+ * @brief   Blend two colours
+ * @param   bgcolor Background colour (16-bit)
+ * @param   fgcolor Foreground colour (16-bit)
+ * @param   level   Foreground weight (0 - top)
+ * @param   top     Full weight
+ * @return  Colour (16-bit)
+ */
+static uint16_t blend(uint16_t bgcolor, uint16_t fgcolor,
+                      uint8_t level, uint8_t top)
+{
+    uint16_t r, g, b;
+
+    r = (((bgcolor >> 11) & 0x1f) * (top - level) +
+         ((fgcolor >> 11) & 0x1f) * level + top / 2) / top;
+    g = (((bgcolor >> 5) & 0x3f) * (top - level) +
+         ((fgcolor >> 5) & 0x3f) * level + top / 2) / top;
+    b = ((bgcolor & 0x1f) * (top - level) +
+         (fgcolor & 0x1f) * level + top / 2) / top;
+
+    return (r << 11) | (g << 5) | b;
+}
+
+/**
+ * @brief   Build the level palette of a font for a colour pair
+ * @param   font    Font
+ * @param   fgcolor Foreground colour (16-bit)
+ * @param   bgcolor Background colour (16-bit)
+ */
+static void set_palette(const font_t *font, uint16_t fgcolor, uint16_t bgcolor)
+{
+    uint8_t top = (1 << font->bpp) - 1;
+    uint8_t level;
+
+    for (level = 0; level <= top; level++)
+    {
+        font_info.palette[level] = blend(bgcolor, fgcolor, level, top);
+    }
+}
+
+/**
+ * @brief   Draw a glyph cell at (x, y) with the current palette
+ *          The cell is clipped to the screen and streamed row by row in one
+ *          window (rows after the first continue the RAMWR)
+ * @param   font    Font
+ * @param   glyph   Glyph
+ * @param   x       x coordinate
+ * @param   y       y coordinate
+ */
+static void draw_glyph(const font_t *font, const font_glyph_t *glyph,
+                       uint16_t x, uint16_t y)
+{
+    uint16_t max_x = tft_get_width() - 1;
+    uint16_t max_y = tft_get_height() - 1;
+    uint16_t *line;
+    uint16_t x1, y1;
+    uint16_t row, col;
+    int16_t  gx, gy;
+
+    if ((glyph->advance == 0) || (x > max_x) || (y > max_y))
+    {
+        return;
+    }
+
+    x1 = min((uint32_t)x + glyph->advance - 1, max_x);
+    y1 = min((uint32_t)y + font->height - 1, max_y);
+
+    for (row = 0; row <= (y1 - y); row++)
+    {
+        line = &font_line[font_info.line_index][0];
+        font_info.line_index ^= 1;
+
+        gy = (int16_t)row - glyph->y_offset;
+
+        for (col = 0; col <= (x1 - x); col++)
+        {
+            gx = (int16_t)col - glyph->x_offset;
+
+            if ((gx >= 0) && (gx < glyph->width) &&
+                (gy >= 0) && (gy < glyph->height))
+            {
+                line[col] = font_info.palette[glyph_level(font, glyph, gx, gy)];
+            }
+            else
+            {
+                line[col] = font_info.palette[0];
+            }
+        }
+
+        tft_write_pixels(x, y + row, x1, y1, line, x1 - x + 1);
+    }
+}
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Check whether a font ID is a generated font
+ * @param   font_id     Font ID
+ * @return  True if font_id is 1 - FONT_TABLE_COUNT
+ */
+bool font_valid(uint8_t font_id)
+{
+    return (font_id != FONT_BUILTIN) && (font_id <= FONT_TABLE_COUNT);
+}
+
+/**
+ * @brief   Line height of a font
+ * @param   font_id     Font ID
+ * @return  Height (pixels), 0 if the font does not exist
+ */
+uint16_t font_get_height(uint8_t font_id)
+{
+    if (!font_valid(font_id))
+    {
+        return 0;
+    }
+
+    return get_font(font_id)->height;
+}
+
+/**
+ * @brief   Width of a string in a font
+ * @param   font_id     Font ID
+ * @param   string      String input. Eg: "abc"
+ * @return  Sum of the advance widths (pixels), 0 if the font does not exist
+ */
+uint16_t font_get_string_width(uint8_t font_id, const char *string)
+{
+    const font_t *font;
+    uint16_t width = 0;
+
+    ASSERT(string != NULL);
+
+    if (!font_valid(font_id))
+    {
+        return 0;
+    }
+
+    font = get_font(font_id);
+
+    while (*string)
+    {
+        width += get_glyph(font, *string)->advance;
+        string++;
+    }
+
+    return width;
+}
+
+/**
+* @brief    Draw string at (x,y) in a generated font
+*           Glyph cells are filled, anti-aliased edges are blended against
+*           the background colour
+* @param    font_id   Font ID (1 - FONT_TABLE_COUNT)
+* @param    string    String input. Eg: "abc"
+* @param    x         x coordinate (left of the first cell)
+* @param    y         y coordinate (top of the line)
+* @param    fgcolor   foreground color
+* @param    bgcolor   background color
+*/
+void font_draw_string(uint8_t font_id, const char *string,
+                      uint16_t x, uint16_t y,
+                      uint16_t fgcolor, uint16_t bgcolor)
+{
+    const font_t *font;
+    const font_glyph_t *glyph;
+
+    ASSERT(string != NULL);
+
+    if (!font_valid(font_id))
+    {
+        return;
+    }
+
+    font = get_font(font_id);
+
+    set_palette(font, fgcolor, bgcolor);
+
+    while (*string && (x < tft_get_width()))
+    {
+        glyph = get_glyph(font, *string);
+
+        draw_glyph(font, glyph, x, y);
+
+        x += glyph->advance;
+        string++;
+    }
+}
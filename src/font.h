@@ -0,0 +1,85 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  font.h
+ *
+ *    Description:  Proportional and anti-aliased font header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 07:02:51 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef FONT_H
+#define FONT_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+
+/*-----------------------------------------------------------------------------
+ *  Constants
+ *-----------------------------------------------------------------------------*/
+
+/* Font ID of the scaled 8x8 font_map (drawn by tft.c) */
+#define FONT_BUILTIN    (0U)
+
+/*-----------------------------------------------------------------------------
+ *  Types
+ *-----------------------------------------------------------------------------*/
+
+/* Glyph of a generated font (see fontgen.py) */
+typedef struct
+{
+    /* First byte of the glyph pixels in the font bitmap */
+    uint16_t offset;
+
+    /* Pixel box, placed within the glyph cell */
+    uint8_t  width;
+    uint8_t  height;
+    uint8_t  x_offset;
+    uint8_t  y_offset;
+
+    /* Cell width, distance to the next glyph */
+    uint8_t  advance;
+} font_glyph_t;
+
+/* Generated font */
+typedef struct
+{
+    /* Cell height (line height) */
+    uint8_t            height;
+
+    /* Bits per pixel: 1, 2 or 4 (anti-aliasing levels) */
+    uint8_t            bpp;
+
+    /* Glyphs FONT_TABLE_FIRST - FONT_TABLE_LAST */
+    const font_glyph_t *glyphs;
+
+    /* Row-major pixels, MSB first */
+    const uint8_t      *bitmap;
+} font_t;
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+bool font_valid(uint8_t font_id);
+uint16_t font_get_height(uint8_t font_id);
+uint16_t font_get_string_width(uint8_t font_id, const char *string);
+void font_draw_string(uint8_t font_id, const char *string,
+                      uint16_t x, uint16_t y,
+                      uint16_t fgcolor, uint16_t bgcolor);
+
+#endif
@@ -0,0 +1,385 @@
+# =============================================================================
+#    Font Table Generator
+#
+#    Compiles fonts into packed glyph tables for font.c. Every font becomes
+#    a bitmap of 1, 2 or 4 bits per pixel (anti-aliasing levels) and a glyph
+#    table with the box and advance width of each printable ASCII character.
+#
+#    Font sources:
+#        builtin                 fonts.h font_map, proportional (1 bpp)
+#        smooth[:bpp]            fonts.h font_map doubled and smoothed
+#                                (16 pixels high, default 4 bpp)
+#        file.bdf                BDF bitmap font (1 bpp)
+#        file.ttf:size[:bpp]     TrueType font rendered at size pixels
+#                                (needs PIL, default 4 bpp)
+#
+#    Font ID 0 is the scaled font_map of tft.c, the fonts given here are
+#    font ID 1, 2...
+#
+#    Usage: python3 fontgen.py fonts.h font_tables.h source...
+# =============================================================================
+
+import re
+import sys
+
+# =============================================================================
+#    Definition
+# =============================================================================
+
+FONT_X = 8
+FONT_Y = 8
+
+# Characters in every table
+FIRST_CHAR = 0x20
+LAST_CHAR = 0x7E
+
+# Largest advance width supported by font.c line buffers
+MAX_ADVANCE = 64
+
+# =============================================================================
+#    Glyph Definition
+# =============================================================================
+
+
+class Glyph:
+
+    def __init__(self, levels, x_off, y_off, advance):
+        # levels: rows of pixel levels (0 - 2^bpp - 1)
+        self.levels = levels
+        self.x_off = x_off
+        self.y_off = y_off
+        self.advance = advance
+
+    @property
+    def width(self):
+        return len(self.levels[0]) if self.levels else 0
+
+    @property
+    def height(self):
+        return len(self.levels)
+
+    def trim(self):
+        # Drop blank rows and columns around the glyph
+        rows = [r for r in range(self.height) if any(self.levels[r])]
+        cols = [c for c in range(self.width)
+                if any(row[c] for row in self.levels)]
+
+        if not rows:
+            self.levels = []
+            self.x_off = 0
+            self.y_off = 0
+            return self
+
+        self.levels = [row[cols[0]:cols[-1] + 1]
+                       for row in self.levels[rows[0]:rows[-1] + 1]]
+        self.x_off += cols[0]
+        self.y_off += rows[0]
+        return self
+
+
+class Font:
+
+    def __init__(self, name, height, bpp, glyphs):
+        self.name = name
+        self.height = height
+        self.bpp = bpp
+        self.glyphs = glyphs
+
+
+# =============================================================================
+#    Font Sources
+# =============================================================================
+
+
+def read_font_map(path):
+    with open(path) as f:
+        text = f.read()
+
+    start = text.index("font_map")
+    body = text[text.index("{", start) + 1:]
+
+    glyphs = []
+    for row in re.findall(r"\{([^{}]*)\}", body):
+        glyphs.append([int(v, 16) for v in re.findall(r"0[xX][0-9a-fA-F]+", row)])
+
+    return glyphs
+
+
+def font_map_bitmap(columns):
+    # Column bytes, LSB is the top row
+    return [[(columns[x] >> y) & 0x01 for x in range(FONT_X)]
+            for y in range(FONT_Y)]
+
+
+def scale2x(bitmap):
+    # EPX/Scale2x: doubles a bitmap and rounds off diagonal steps
+    h = len(bitmap)
+    w = len(bitmap[0])
+
+    def at(x, y):
+        if 0 <= x < w and 0 <= y < h:
+            return bitmap[y][x]
+        return 0
+
+    out = [[0] * (2 * w) for _ in range(2 * h)]
+    for y in range(h):
+        for x in range(w):
+            p = at(x, y)
+            a, b, c, d = at(x, y - 1), at(x + 1, y), at(x - 1, y), at(x, y + 1)
+            out[2 * y][2 * x] = a if (c == a and c != d and a != b) else p
+            out[2 * y][2 * x + 1] = b if (a == b and a != c and b != d) else p
+            out[2 * y + 1][2 * x] = c if (d == c and d != b and c != a) else p
+            out[2 * y + 1][2 * x + 1] = d if (b == d and b != a and d != c) else p
+
+    return out
+
+
+def quantise(value, maximum, bpp):
+    # value / maximum coverage to a level of bpp bits
+    top = (1 << bpp) - 1
+    return (value * top + maximum // 2) // maximum
+
+
+def font_builtin(fonts_h):
+    glyphs = []
+    for columns in read_font_map(fonts_h)[:LAST_CHAR - FIRST_CHAR + 1]:
+        glyph = Glyph(font_map_bitmap(columns), 0, 0, 0).trim()
+        glyph.advance = glyph.width + 1 if glyph.levels else 3
+        glyph.x_off = 0
+        glyphs.append(glyph)
+
+    return Font("builtin", FONT_Y, 1, glyphs)
+
+
+def font_smooth(fonts_h, bpp):
+    glyphs = []
+    for columns in read_font_map(fonts_h)[:LAST_CHAR - FIRST_CHAR + 1]:
+        # 4x with rounded diagonals, then 2x2 box filter to 2x
+        big = scale2x(scale2x(font_map_bitmap(columns)))
+        levels = [[quantise(big[2 * y][2 * x] + big[2 * y][2 * x + 1] +
+                            big[2 * y + 1][2 * x] + big[2 * y + 1][2 * x + 1],
+                            4, bpp)
+                   for x in range(2 * FONT_X)]
+                  for y in range(2 * FONT_Y)]
+        glyph = Glyph(levels, 0, 0, 0).trim()
+        glyph.advance = glyph.width + 2 if glyph.levels else 6
+        glyph.x_off = 0
+        glyphs.append(glyph)
+
+    return Font("smooth", 2 * FONT_Y, bpp, glyphs)
+
+
+def font_bdf(path):
+    ascent = descent = None
+    glyphs = {}
+    encoding = advance = None
+    bbx = None
+    rows = None
+
+    with open(path) as f:
+        for line in f:
+            words = line.split()
+            if not words:
+                continue
+            key = words[0]
+            if key == "FONT_ASCENT":
+                ascent = int(words[1])
+            elif key == "FONT_DESCENT":
+                descent = int(words[1])
+            elif key == "ENCODING":
+                encoding = int(words[1])
+            elif key == "DWIDTH":
+                advance = int(words[1])
+            elif key == "BBX":
+                bbx = [int(v) for v in words[1:5]]
+            elif key == "BITMAP":
+                rows = []
+            elif key == "ENDCHAR":
+                w, h, bx, by = bbx
+                levels = [[(int(r, 16) >> (len(r) * 4 - 1 - x)) & 0x01
+                           for x in range(w)] for r in rows]
+                # BDF boxes are relative to the baseline, y up
+                glyphs[encoding] = Glyph(levels, bx, ascent - by - h, advance)
+                rows = None
+            elif rows is not None:
+                rows.append(key)
+
+    if ascent is None or descent is None:
+        raise ValueError(path + ": FONT_ASCENT/FONT_DESCENT missing")
+
+    return Font(path, ascent + descent, 1, fill_missing(glyphs))
+
+
+def font_ttf(path, size, bpp):
+    from PIL import Image, ImageDraw, ImageFont
+
+    face = ImageFont.truetype(path, size)
+    ascent, descent = face.getmetrics()
+
+    glyphs = {}
+    for code in range(FIRST_CHAR, LAST_CHAR + 1):
+        c = chr(code)
+        advance = int(round(face.getlength(c)))
+        x0, y0, x1, y1 = face.getbbox(c, anchor="la")
+
+        levels = []
+        if x1 > x0 and y1 > y0:
+            image = Image.new("L", (x1 - x0, y1 - y0), 0)
+            ImageDraw.Draw(image).text((-x0, -y0), c, font=face, fill=255,
+                                       anchor="la")
+            levels = [[quantise(image.getpixel((x, y)), 255, bpp)
+                       for x in range(x1 - x0)] for y in range(y1 - y0)]
+
+        glyphs[code] = Glyph(levels, x0, y0, advance).trim()
+
+    return Font(path, ascent + descent, bpp, fill_missing(glyphs))
+
+
+def fill_missing(glyphs):
+    # Characters missing from a font are drawn as '?'
+    fallback = glyphs.get(ord("?"), Glyph([], 0, 0, 0))
+    return [glyphs.get(code, fallback)
+            for code in range(FIRST_CHAR, LAST_CHAR + 1)]
+
+
+def load(source, fonts_h):
+    spec = source.split(":")
+    name = spec[0]
+
+    if name == "builtin":
+        return font_builtin(fonts_h)
+    if name == "smooth":
+        return font_smooth(fonts_h, int(spec[1]) if len(spec) > 1 else 4)
+    if name.lower().endswith(".bdf"):
+        return font_bdf(name)
+    if name.lower().endswith((".ttf", ".otf")):
+        return font_ttf(name, int(spec[1]), int(spec[2]) if len(spec) > 2 else 4)
+
+    raise ValueError("unknown font source: " + source)
+
+
+# =============================================================================
+#    Table Output
+# =============================================================================
+
+
+def pack(font):
+    # Row-major pixels, MSB first, a glyph starts on a byte boundary
+    bitmap = []
+    table = []
+    packed = {}
+
+    for glyph in font.glyphs:
+        # Missing characters share the '?' glyph
+        if id(glyph) in packed:
+            table.append(packed[id(glyph)])
+            continue
+
+        # Clip glyph to its cell (negative bearings, tall glyphs)
+        x_off = max(glyph.x_off, 0)
+        y_off = max(glyph.y_off, 0)
+        levels = [row[x_off - glyph.x_off:][:max(glyph.advance - x_off, 0)]
+                  for row in glyph.levels[y_off - glyph.y_off:]
+                  [:max(font.height - y_off, 0)]]
+        if not levels or not levels[0]:
+            levels = []
+            x_off = y_off = 0
+
+        packed[id(glyph)] = (len(bitmap),
+                             len(levels[0]) if levels else 0,
+                             len(levels),
+                             x_off, y_off,
+                             glyph.advance)
+        table.append(packed[id(glyph)])
+
+        acc = 0
+        bits = 0
+        for row in levels:
+            for level in row:
+                acc = (acc << font.bpp) | level
+                bits += font.bpp
+                if bits == 8:
+                    bitmap.append(acc)
+                    acc = 0
+                    bits = 0
+        if bits:
+            bitmap.append(acc << (8 - bits))
+
+    return bitmap, table
+
+
+def printable(code):
+    c = chr(code)
+    if c in "\\'*/":
+        return "0x%02X" % code
+    return "'" + c + "'"
+
+
+def main(fonts_h, dst, sources):
+    fonts = [load(source, fonts_h) for source in sources]
+
+    out = []
+    out.append("/*")
+    out.append(" * Generated by fontgen.py - do not edit")
+    for i, font in enumerate(fonts):
+        out.append(" * Font %d: %s, %d pixels high, %d bpp"
+                   % (i + 1, font.name, font.height, font.bpp))
+    out.append(" */")
+    out.append("")
+    out.append("#ifndef FONT_TABLES_H")
+    out.append("#define FONT_TABLES_H")
+    out.append("")
+    out.append("#define FONT_TABLE_COUNT        (%dU)" % len(fonts))
+    out.append("#define FONT_TABLE_FIRST        (0x%02XU)" % FIRST_CHAR)
+    out.append("#define FONT_TABLE_LAST         (0x%02XU)" % LAST_CHAR)
+    out.append("")
+
+    max_advance = 0
+    for i, font in enumerate(fonts):
+        bitmap, table = pack(font)
+        max_advance = max([max_advance] + [g[5] for g in table])
+
+        if max_advance > MAX_ADVANCE or font.height > 255:
+            raise ValueError(font.name + ": glyphs too large")
+        if font.bpp not in (1, 2, 4):
+            raise ValueError(font.name + ": bpp must be 1, 2 or 4")
+
+        out.append("static const uint8_t font_%d_bitmap[%d] =" % (i + 1, max(len(bitmap), 1)))
+        out.append("{")
+        for j in range(0, len(bitmap), 12):
+            out.append("    " + ", ".join("0x%02X" % v for v in bitmap[j:j + 12]) + ",")
+        if not bitmap:
+            out.append("    0x00")
+        out[-1] = out[-1].rstrip(",")
+        out.append("};")
+        out.append("")
+        out.append("/* offset, width, height, x offset, y offset, advance */")
+        out.append("static const font_glyph_t font_%d_glyphs[%d] =" % (i + 1, len(table)))
+        out.append("{")
+        for code, g in zip(range(FIRST_CHAR, LAST_CHAR + 1), table):
+            out.append("    {%5d, %2d, %2d, %2d, %2d, %2d},    /* %s */"
+                       % (g + (printable(code),)))
+        out[-1] = out[-1].replace("},", "} ", 1)
+        out.append("};")
+        out.append("")
+
+    out.append("/* Widest glyph cell of all fonts */")
+    out.append("#define FONT_TABLE_MAX_ADVANCE  (%dU)" % max_advance)
+    out.append("")
+    out.append("/* height, bpp, glyphs, bitmap */")
+    out.append("static const font_t font_table[FONT_TABLE_COUNT] =")
+    out.append("{")
+    for i, font in enumerate(fonts):
+        out.append("    {%d, %d, font_%d_glyphs, font_%d_bitmap},"
+                   % (font.height, font.bpp, i + 1, i + 1))
+    out[-1] = out[-1].rstrip(",")
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+
+    with open(dst, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main(sys.argv[1], sys.argv[2], sys.argv[3:])
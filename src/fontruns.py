@@ -0,0 +1,119 @@
+# =============================================================================
+#    Font Run Table Generator
+#
+#    Reads font_map from fonts.h and writes, for every glyph, the maximal
+#    horizontal runs of set bits per glyph row. Used by the transparent text
+#    path of tft.c so it never walks the bitmap bit by bit.
+#
+#    Usage: python3 fontruns.py fonts.h font_runs.h
+# =============================================================================
+
+import re
+import sys
+
+# =============================================================================
+#    Definition
+# =============================================================================
+
+FONT_X = 8
+FONT_Y = 8
+
+# First ASCII character of font_map
+FONT_FIRST = 0x20
+
+# =============================================================================
+#    Helper Function
+# =============================================================================
+
+
+def read_font_map(path):
+    with open(path) as f:
+        text = f.read()
+
+    start = text.index("font_map")
+    body = text[text.index("{", start) + 1:]
+
+    glyphs = []
+    for row in re.findall(r"\{([^{}]*)\}", body):
+        glyphs.append([int(v, 16) for v in re.findall(r"0[xX][0-9a-fA-F]+", row)])
+
+    return glyphs
+
+
+def glyph_runs(columns):
+    # Column bytes, LSB is the top row
+    runs = []
+
+    for row in range(FONT_Y):
+        x = 0
+        while x < FONT_X:
+            if (columns[x] >> row) & 0x01:
+                x0 = x
+                while (x + 1 < FONT_X) and ((columns[x + 1] >> row) & 0x01):
+                    x += 1
+                runs.append((row, x0, x))
+            x += 1
+
+    return runs
+
+
+def printable(index):
+    c = chr(FONT_FIRST + index)
+    if c in "\\'" or not c.isprintable():
+        return "0x%02X" % (FONT_FIRST + index)
+    return "'" + c + "'"
+
+
+# =============================================================================
+#    Main Program
+# =============================================================================
+
+
+def main(src, dst):
+    glyphs = read_font_map(src)
+
+    index = [0]
+    table = []
+    for i, columns in enumerate(glyphs):
+        runs = glyph_runs(columns)
+        table.append((i, runs))
+        index.append(index[-1] + len(runs))
+
+    out = []
+    out.append("/*")
+    out.append(" * Generated by fontruns.py from fonts.h - do not edit")
+    out.append(" * Horizontal runs of set bits per glyph row: {row, x0, x1}")
+    out.append(" */")
+    out.append("")
+    out.append("#ifndef FONT_RUNS_H")
+    out.append("#define FONT_RUNS_H")
+    out.append("")
+    out.append("#define FONT_RUN_GLYPHS     (%dU)" % len(glyphs))
+    out.append("#define FONT_RUN_COUNT      (%dU)" % index[-1])
+    out.append("")
+    out.append("/* First run of each glyph, runs are sorted by row */")
+    out.append("static const uint16_t font_run_index[FONT_RUN_GLYPHS + 1] =")
+    out.append("{")
+    for i in range(0, len(index), 8):
+        out.append("    " + ", ".join("%4d" % v for v in index[i:i + 8]) + ",")
+    out[-1] = out[-1].rstrip(",")
+    out.append("};")
+    out.append("")
+    out.append("static const uint8_t font_runs[FONT_RUN_COUNT][3] =")
+    out.append("{")
+    for i, runs in table:
+        if runs:
+            out.append("    /* %s */" % printable(i))
+            for run in runs:
+                out.append("    {%d, %d, %d}," % run)
+    out[-1] = out[-1].rstrip(",")
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+
+    with open(dst, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main(sys.argv[1], sys.argv[2])
@@ -32,7 +32,7 @@
 #define TFT_FONT_X  8
 #define TFT_FONT_Y  8
 
-const uint8_t font_map[][8] = 
+static const uint8_t font_map[][8] = 
 {
     {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
     {0x00,0x00,0x5F,0x00,0x00,0x00,0x00,0x00},
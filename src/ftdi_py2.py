@@ -4,6 +4,7 @@
 
 import serial
 import numpy
+import math
 import time
 import datetime
 import sys
@@ -17,6 +18,10 @@ from PIL import Image
 STX = 2
 ETX = 3
 
+# Frame Definition
+FRM_END = 0
+FRM_BEGIN = 1
+
 # Command Definition
 CMD_BLK = 0
 CMD_IMG = 1
@@ -24,6 +29,58 @@ CMD_STR = 2
 CMD_CLR = 3
 CMD_RAW = 4
 CMD_SQB = 5
+CMD_FRM = 6
+CMD_STA = 7
+CMD_TRM = 8
+CMD_CHR = 9
+CMD_SCP = 10
+CMD_FLD = 11
+CMD_NUM = 12
+CMD_AST = 13
+CMD_QOI = 14
+CMD_RLE = 15
+CMD_PAL = 16
+CMD_MSK = 17
+CMD_JPG = 18
+CMD_TIL = 19
+CMD_MAP = 20
+CMD_CEL = 21
+CMD_ATL = 22
+CMD_SPR = 23
+CMD_MOV = 24
+
+# Mask Flag
+MSK_TRANSPARENT = 0x01
+
+# Sprite Flag
+SPR_VISIBLE = 0x01
+SPR_TILE_BG = 0x02
+
+# Transparent colour of RGB565 sprite atlases
+SPRITE_KEY = 0xF81F
+
+# Terminal Operation
+TRM_STOP = 0
+TRM_START = 1
+TRM_WRITE = 2
+
+# Chart Operation
+CHR_REGISTER = 0
+CHR_SAMPLE = 1
+CHR_REMOVE = 2
+
+# Scope Operation
+SCP_REGISTER = 0
+SCP_TRACE8 = 1
+SCP_TRACE16 = 2
+SCP_REMOVE = 3
+
+# Numeric Field Alignment
+FLD_LEFT = 0
+FLD_RIGHT = 1
+
+# Font ID of the scaled 8x8 font (generated fonts are 1, 2...)
+FONT_BUILTIN = 0
 
 
 # Color Definition
@@ -69,6 +126,190 @@ def convert_16_bit_color(r, g, b):
     return r
 
 
+def read_image(img, colors=None):
+    # RGB565 pixels row by row, reduced to colors colours if given
+    image = Image.open(img).convert("RGB")
+    if colors:
+        image = image.convert("P", palette=Image.ADAPTIVE,
+                              colors=colors).convert("RGB")
+
+    array_1d = numpy.asarray(image).ravel()
+
+    pixels = []
+    for i in range(int(len(array_1d) / 3)):
+        pixels.append(convert_16_bit_color(array_1d[(3 * i)],
+                                           array_1d[(3 * i) + 1],
+                                           array_1d[(3 * i) + 2]))
+
+    return image.size, pixels
+
+
+def image_param(cmd, pos, size):
+    return [cmd,
+            high_byte(pos[0]), low_byte(pos[0]),
+            high_byte(pos[1]), low_byte(pos[1]),
+            high_byte(size[0]), low_byte(size[0]),
+            high_byte(size[1]), low_byte(size[1])]
+
+
+def rle_encode_row(row):
+    # Runs of 2 or more pixels, the others gathered into literals
+    out = []
+    literal = []
+    x = 0
+
+    while x < len(row):
+        n = 1
+        while x + n < len(row) and row[x + n] == row[x] and n < 128:
+            n += 1
+
+        if n >= 2:
+            out += literal_encode_row(literal)
+            literal = []
+            out += [0x80 | (n - 1), high_byte(row[x]), low_byte(row[x])]
+        else:
+            literal.append(row[x])
+
+        x += n
+
+    return out + literal_encode_row(literal)
+
+
+def literal_encode_row(row):
+    out = []
+
+    for i in range(0, len(row), 128):
+        out.append(len(row[i:i + 128]) - 1)
+        for color in row[i:i + 128]:
+            out += [high_byte(color), low_byte(color)]
+
+    return out
+
+
+def rle_encode(pixels, width):
+    # Every row is sent as runs or as literals, whichever is shorter
+    out = []
+
+    for y in range(0, len(pixels), width):
+        row = pixels[y:y + width]
+        rle = rle_encode_row(row)
+        literal = literal_encode_row(row)
+        out += rle if len(rle) < len(literal) else literal
+
+    return out
+
+
+def palette_encode(pixels, width):
+    # Smallest depth holding every colour, rows start on a new byte
+    colors = sorted(set(pixels))
+    if len(colors) > 256:
+        raise ValueError("more than 256 colours")
+
+    bpp = 8
+    for depth in (1, 2, 4):
+        if len(colors) <= (1 << depth):
+            bpp = depth
+            break
+
+    lookup = dict((color, i) for i, color in enumerate(colors))
+
+    out = [bpp, len(colors) & 0xff]
+    for color in colors:
+        out += [high_byte(color), low_byte(color)]
+
+    for y in range(0, len(pixels), width):
+        byte = 0
+        bits = 0
+        for color in pixels[y:y + width]:
+            byte = (byte << bpp) | lookup[color]
+            bits += bpp
+            if bits == 8:
+                out.append(byte)
+                byte = 0
+                bits = 0
+        if bits > 0:
+            out.append(byte << (8 - bits))
+
+    return out
+
+
+def mask_encode(img):
+    # 1 bpp rows (bright pixels set), MSB first, rows start on a new byte
+    image = Image.open(img).convert("L")
+    width = image.size[0]
+    levels = list(image.getdata())
+
+    out = []
+    for y in range(0, len(levels), width):
+        row = levels[y:y + width]
+        for x in range(0, width, 8):
+            byte = 0
+            for i, level in enumerate(row[x:x + 8]):
+                if level >= 128:
+                    byte |= 0x80 >> i
+            out.append(byte)
+
+    return image.size, out
+
+
+def qoi_hash(color):
+    return (((color >> 11) & 0x1f) * 3 + ((color >> 5) & 0x3f) * 5 +
+            (color & 0x1f) * 7) % 64
+
+
+def qoi_wrap(value, bits):
+    # Signed difference of a channel that wraps at bits
+    value &= (1 << bits) - 1
+    if value >= (1 << (bits - 1)):
+        value -= (1 << bits)
+    return value
+
+
+def qoi_encode(pixels):
+    # QOI-style RGB565 encoding, see qoi.c for the operations
+    index = [0] * 64
+    prev = 0
+    run = 0
+    out = []
+
+    for i in range(len(pixels)):
+        color = pixels[i]
+
+        if color == prev:
+            run += 1
+            if run == 62 or i == len(pixels) - 1:
+                out.append(0xC0 | (run - 1))
+                run = 0
+            continue
+
+        if run > 0:
+            out.append(0xC0 | (run - 1))
+            run = 0
+
+        slot = qoi_hash(color)
+        dr = qoi_wrap((color >> 11) - (prev >> 11), 5)
+        dg = qoi_wrap((color >> 5) - (prev >> 5), 6)
+        db = qoi_wrap(color - prev, 5)
+        half = int(dg / 2)
+
+        if index[slot] == color:
+            out.append(slot)
+        elif -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+            out.append(0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2))
+        elif -8 <= qoi_wrap(dr - half, 5) <= 7 and \
+                -8 <= qoi_wrap(db - half, 5) <= 7:
+            out.append(0x80 | (dg + 32))
+            out.append(((qoi_wrap(dr - half, 5) + 8) << 4) |
+                       (qoi_wrap(db - half, 5) + 8))
+        else:
+            out += [0xFE, high_byte(color), low_byte(color)]
+
+        index[slot] = color
+        prev = color
+
+    return out
+
+
 # =============================================================================
 #    Command Class Definition
 # =============================================================================
@@ -172,11 +413,14 @@ class BlockCommand(object):
 
 class StringCommand(object):
 
-    def set_param(self, pos, font_size, color, text):
+    def set_param(self, pos, font_size, color, text, font_id=FONT_BUILTIN,
+                  bgcolor=BLACK):
         self._pos = pos
         self._font_size = font_size
         self._color = color
         self._text = text
+        self._font_id = font_id
+        self._bgcolor = bgcolor
 
         param = [CMD_STR]
 
@@ -193,6 +437,14 @@ class StringCommand(object):
         param.append(high_byte(color))
         param.append(low_byte(color))
 
+        # Font ID (FONT_BUILTIN is scaled by font_size, others are generated
+        # fonts drawn on bgcolor)
+        param.append(font_id)
+
+        # Background Color
+        param.append(high_byte(bgcolor))
+        param.append(low_byte(bgcolor))
+
         # text
         for i in range(len(text)):
             param.append(ord(text[i]))
@@ -201,20 +453,28 @@ class StringCommand(object):
             " with font_size " + str(font_size) + " and color " + str(color)
         self._command.param = param
 
-    def __init__(self, pos, font_size, color, text):
+    def __init__(self, pos, font_size, color, text, font_id=FONT_BUILTIN,
+                 bgcolor=BLACK):
         self._command = Command()
 
-        StringCommand.set_param(self, pos, font_size, color, text)
+        StringCommand.set_param(self, pos, font_size, color, text, font_id,
+                                bgcolor)
 
 
 class ImageCommand(object):
 
-    def set_param(self, pos, img):
+    def set_param(self, pos, img, scale=(1, 1)):
         try:
             self._img = Image.open(img)
         except:
             raise
 
+        # Send a reduced image, the device draws every pixel scale[0] wide
+        # and scale[1] high
+        if scale[0] > 1 or scale[1] > 1:
+            self._img = self._img.resize((max(1, self._img.size[0] // scale[0]),
+                                          max(1, self._img.size[1] // scale[1])))
+
         self._pos = pos
         self._array = numpy.asarray(self._img)
 
@@ -236,6 +496,10 @@ class ImageCommand(object):
         param.append(high_byte(self._img.size[1]))
         param.append(low_byte(self._img.size[1]))
 
+        # Scale
+        param.append(scale[0])
+        param.append(scale[1])
+
         pixel = int(len(array_1d) / 3)
         for i in range(pixel):
             r = array_1d[(3 * i)]
@@ -249,10 +513,230 @@ class ImageCommand(object):
 
         self._command.param = param
 
+    def __init__(self, pos, img, scale=(1, 1)):
+        self._command = Command()
+
+        ImageCommand.set_param(self, pos, img, scale)
+
+
+class QoiImageCommand(object):
+
+    def set_param(self, pos, img):
+        size, pixels = read_image(img)
+        data = qoi_encode(pixels)
+
+        self._command.info = "QOI image " + str(len(data)) + " bytes (raw " + \
+            str(2 * len(pixels)) + ")"
+        self._command.param = image_param(CMD_QOI, pos, size) + data
+
     def __init__(self, pos, img):
         self._command = Command()
 
-        ImageCommand.set_param(self, pos, img)
+        QoiImageCommand.set_param(self, pos, img)
+
+
+class RleImageCommand(object):
+
+    def set_param(self, pos, img):
+        size, pixels = read_image(img)
+        data = rle_encode(pixels, size[0])
+
+        self._command.info = "RLE image " + str(len(data)) + " bytes (raw " + \
+            str(2 * len(pixels)) + ")"
+        self._command.param = image_param(CMD_RLE, pos, size) + data
+
+    def __init__(self, pos, img):
+        self._command = Command()
+
+        RleImageCommand.set_param(self, pos, img)
+
+
+class PaletteImageCommand(object):
+
+    def set_param(self, pos, img, colors=None):
+        size, pixels = read_image(img, colors)
+        data = palette_encode(pixels, size[0])
+
+        self._command.info = "Indexed image " + str(data[0]) + " bpp, " + \
+            str(len(data)) + " bytes (raw " + str(2 * len(pixels)) + ")"
+        self._command.param = image_param(CMD_PAL, pos, size) + data
+
+    def __init__(self, pos, img, colors=None):
+        self._command = Command()
+
+        PaletteImageCommand.set_param(self, pos, img, colors)
+
+
+class MaskCommand(object):
+
+    def set_param(self, pos, img, color, bgcolor, transparent=False):
+        size, data = mask_encode(img)
+
+        self._command.info = "Mask " + str(len(data)) + " bytes"
+        self._command.param = image_param(CMD_MSK, pos, size) + \
+            [high_byte(color), low_byte(color),
+             high_byte(bgcolor), low_byte(bgcolor),
+             MSK_TRANSPARENT if transparent else 0] + data
+
+    def __init__(self, pos, img, color, bgcolor, transparent=False):
+        self._command = Command()
+
+        MaskCommand.set_param(self, pos, img, color, bgcolor, transparent)
+
+
+class JpegCommand(object):
+
+    def set_param(self, pos, path):
+        with open(path, "rb") as f:
+            data = list(bytearray(f.read()))
+
+        self._command.info = "JPEG " + str(len(data)) + " bytes"
+        self._command.param = [CMD_JPG,
+                               high_byte(pos[0]), low_byte(pos[0]),
+                               high_byte(pos[1]), low_byte(pos[1])] + data
+
+    def __init__(self, pos, path):
+        self._command = Command()
+
+        JpegCommand.set_param(self, pos, path)
+
+
+class TileSetCommand(object):
+
+    def set_param(self, size, tiles, palette=None, first=0):
+        data = []
+
+        # RGB565 tiles, or 4-bpp tiles after a 16 colour palette
+        if palette is None:
+            bpp = 16
+            for tile in tiles:
+                for pixel in tile:
+                    data += [high_byte(pixel), low_byte(pixel)]
+        else:
+            bpp = 4
+            for color in palette + [0] * (16 - len(palette)):
+                data += [high_byte(color), low_byte(color)]
+            for tile in tiles:
+                for i in range(0, len(tile), 2):
+                    data.append((tile[i] << 4) | tile[i + 1])
+
+        self._command.info = "Tile Set " + str(len(tiles)) + " tiles"
+        self._command.param = [CMD_TIL, size, bpp, first] + data
+
+    def __init__(self, size, tiles, palette=None, first=0):
+        self._command = Command()
+
+        TileSetCommand.set_param(self, size, tiles, palette, first)
+
+
+class TileMapCommand(object):
+
+    def set_param(self, pos, cols, cells):
+        self._command.info = "Tile Map " + str(len(cells)) + " cells"
+        self._command.param = [CMD_MAP,
+                               high_byte(pos[0]), low_byte(pos[0]),
+                               high_byte(pos[1]), low_byte(pos[1]),
+                               cols, len(cells) // cols] + cells
+
+    def __init__(self, pos, cols, cells):
+        self._command = Command()
+
+        TileMapCommand.set_param(self, pos, cols, cells)
+
+
+class CellCommand(object):
+
+    def set_param(self, cells):
+        param = [CMD_CEL]
+
+        # (column, row, tile index) of every changed cell
+        for cell in cells:
+            param += list(cell)
+
+        self._command.info = "Cells " + str(len(cells))
+        self._command.param = param
+
+    def __init__(self, cells):
+        self._command = Command()
+
+        CellCommand.set_param(self, cells)
+
+
+class AtlasCommand(object):
+
+    def set_param(self, width, pixels, palette=None):
+        height = len(pixels) // width
+        data = []
+
+        # RGB565 atlas, or 4-bpp atlas (rows byte aligned) after a 16
+        # colour palette
+        if palette is None:
+            bpp = 16
+            for pixel in pixels:
+                data += [high_byte(pixel), low_byte(pixel)]
+        else:
+            bpp = 4
+            for color in palette + [0] * (16 - len(palette)):
+                data += [high_byte(color), low_byte(color)]
+            for y in range(height):
+                row = pixels[y * width:(y + 1) * width] + [0]
+                for x in range(0, width, 2):
+                    data.append((row[x] << 4) | row[x + 1])
+
+        self._command.info = "Atlas " + str(width) + "x" + str(height)
+        self._command.param = [CMD_ATL,
+                               high_byte(width), low_byte(width),
+                               high_byte(height), low_byte(height),
+                               bpp] + data
+
+    def __init__(self, width, pixels, palette=None):
+        self._command = Command()
+
+        AtlasCommand.set_param(self, width, pixels, palette)
+
+
+class SpriteCommand(object):
+
+    def set_param(self, sprite_id, src, size, pos, z, bgcolor,
+                  tile_bg=False, visible=True):
+        flags = (SPR_VISIBLE if visible else 0) | \
+            (SPR_TILE_BG if tile_bg else 0)
+
+        self._command.info = "Sprite " + str(sprite_id)
+        self._command.param = [CMD_SPR, sprite_id,
+                               high_byte(src[0]), low_byte(src[0]),
+                               high_byte(src[1]), low_byte(src[1]),
+                               size[0], size[1],
+                               high_byte(pos[0]), low_byte(pos[0]),
+                               high_byte(pos[1]), low_byte(pos[1]),
+                               z, flags,
+                               high_byte(bgcolor), low_byte(bgcolor)]
+
+    def __init__(self, sprite_id, src, size, pos, z, bgcolor,
+                 tile_bg=False, visible=True):
+        self._command = Command()
+
+        SpriteCommand.set_param(self, sprite_id, src, size, pos, z, bgcolor,
+                                tile_bg, visible)
+
+
+class MoveCommand(object):
+
+    def set_param(self, moves):
+        param = [CMD_MOV]
+
+        # (sprite ID, x, y) of every moved sprite
+        for sprite_id, x, y in moves:
+            param += [sprite_id, high_byte(x), low_byte(x),
+                      high_byte(y), low_byte(y)]
+
+        self._command.info = "Move " + str(len(moves)) + " sprites"
+        self._command.param = param
+
+    def __init__(self, moves):
+        self._command = Command()
+
+        MoveCommand.set_param(self, moves)
 
 
 class RawCommand(object):
@@ -323,6 +807,176 @@ class SqbCommand(object):
         SqbCommand.set_param(self, ref, size, color, pos_list)
 
 
+class FrameCommand(object):
+
+    def set_param(self, begin):
+        self._begin = begin
+
+        if begin:
+            self._command.info = "Begin frame"
+            self._command.param = [CMD_FRM, FRM_BEGIN]
+        else:
+            self._command.info = "End frame"
+            self._command.param = [CMD_FRM, FRM_END]
+
+    def __init__(self, begin):
+        self._command = Command()
+
+        FrameCommand.set_param(self, begin)
+
+
+class TerminalCommand(object):
+
+    def start(self, top, bottom, font_size, color, bgcolor):
+        self._command.info = "Start terminal"
+        self._command.param = [CMD_TRM, TRM_START,
+                               high_byte(top), low_byte(top),
+                               high_byte(bottom), low_byte(bottom),
+                               font_size,
+                               high_byte(color), low_byte(color),
+                               high_byte(bgcolor), low_byte(bgcolor)]
+
+    def write(self, text):
+        self._command.info = "Terminal " + repr(text)
+        self._command.param = [CMD_TRM, TRM_WRITE] + [ord(c) for c in text]
+
+    def stop(self):
+        self._command.info = "Stop terminal"
+        self._command.param = [CMD_TRM, TRM_STOP]
+
+    def __init__(self):
+        self._command = Command()
+
+
+class ChartCommand(object):
+
+    def register(self, chart_id, pos, size, value_range, color, bgcolor):
+        self._command.info = "Register chart " + str(chart_id)
+        param = [CMD_CHR, CHR_REGISTER, chart_id]
+        for value in (pos[0], pos[1], size[0], size[1],
+                      value_range[0] & 0xffff, value_range[1] & 0xffff,
+                      color, bgcolor):
+            param.append(high_byte(value))
+            param.append(low_byte(value))
+        self._command.param = param
+
+    def samples(self, chart_id, values):
+        self._command.info = "Chart " + str(chart_id) + " samples"
+        param = [CMD_CHR, CHR_SAMPLE, chart_id]
+        for value in values:
+            param.append(high_byte(value & 0xffff))
+            param.append(low_byte(value & 0xffff))
+        self._command.param = param
+
+    def remove(self, chart_id):
+        self._command.info = "Remove chart " + str(chart_id)
+        self._command.param = [CMD_CHR, CHR_REMOVE, chart_id]
+
+    def __init__(self):
+        self._command = Command()
+
+
+class ScopeCommand(object):
+
+    def register(self, scope_id, pos, size, value_range, color, bgcolor):
+        self._command.info = "Register scope " + str(scope_id)
+        param = [CMD_SCP, SCP_REGISTER, scope_id]
+        for value in (pos[0], pos[1], size[0], size[1],
+                      value_range[0] & 0xffff, value_range[1] & 0xffff,
+                      color, bgcolor):
+            param.append(high_byte(value))
+            param.append(low_byte(value))
+        self._command.param = param
+
+    def trace(self, scope_id, values):
+        # 8-bit samples when they all fit, 16-bit otherwise
+        self._command.info = "Scope " + str(scope_id) + " trace"
+        if all(0 <= value <= 255 for value in values):
+            param = [CMD_SCP, SCP_TRACE8, scope_id] + list(values)
+        else:
+            param = [CMD_SCP, SCP_TRACE16, scope_id]
+            for value in values:
+                param.append(high_byte(value & 0xffff))
+                param.append(low_byte(value & 0xffff))
+        self._command.param = param
+
+    def remove(self, scope_id):
+        self._command.info = "Remove scope " + str(scope_id)
+        self._command.param = [CMD_SCP, SCP_REMOVE, scope_id]
+
+    def __init__(self):
+        self._command = Command()
+
+
+class FieldCommand(object):
+
+    def set_param(self, field_id, pos, font_size, color, bgcolor, width,
+                  align):
+        self._command.info = "Register field " + str(field_id)
+        self._command.param = [CMD_FLD, field_id,
+                               high_byte(pos[0]), low_byte(pos[0]),
+                               high_byte(pos[1]), low_byte(pos[1]),
+                               font_size,
+                               high_byte(color), low_byte(color),
+                               high_byte(bgcolor), low_byte(bgcolor),
+                               width, align]
+
+    def __init__(self, field_id, pos, font_size, color, bgcolor, width,
+                 align):
+        self._command = Command()
+
+        FieldCommand.set_param(self, field_id, pos, font_size, color,
+                               bgcolor, width, align)
+
+
+class NumberCommand(object):
+
+    def set_param(self, field_id, value):
+        value &= 0xffffffff
+        self._command.info = "Field " + str(field_id) + " = " + str(value)
+        self._command.param = [CMD_NUM, field_id,
+                               high_word_high_byte(value),
+                               high_word_low_byte(value),
+                               high_byte(value), low_byte(value)]
+
+    def __init__(self, field_id, value):
+        self._command = Command()
+
+        NumberCommand.set_param(self, field_id, value)
+
+
+class AssetCommand(object):
+
+    def set_param(self, asset_id, pos):
+        self._command.info = "Asset " + str(asset_id)
+        self._command.param = [CMD_AST, asset_id,
+                               high_byte(pos[0]), low_byte(pos[0]),
+                               high_byte(pos[1]), low_byte(pos[1])]
+
+    def __init__(self, asset_id, pos):
+        self._command = Command()
+
+        AssetCommand.set_param(self, asset_id, pos)
+
+
+class PayloadCommand(object):
+
+    # Any command with its parameters and payload as given
+
+    def __init__(self, info, param):
+        self._command = Command()
+        self._command.info = info
+        self._command.param = param
+
+
+class StatusCommand(object):
+
+    def __init__(self):
+        self._command = Command()
+        self._command.info = "Read Status"
+        self._command.param = [CMD_STA]
+
+
 # =============================================================================
 #    Ftdi Class Definition
 # =============================================================================
@@ -356,6 +1010,20 @@ class Ftdi(object):
         elapsed = datetime.datetime.now() - start_time
         print elapsed
 
+    def read_status(self):
+        # STX, CMD_STA, size (4), hits (4), misses (4), saved bytes (4), ETX
+        reply = bytearray(self.ser.read(19))
+        if reply[0] != STX or reply[1] != CMD_STA or reply[-1] != ETX:
+            print "Invalid status reply :", list(reply)
+            return
+        value = [0, 0, 0]
+        for i in range(3):
+            for b in reply[6 + 4 * i:10 + 4 * i]:
+                value[i] = (value[i] << 8) | b
+        print "Glyph cache hits   :", value[0]
+        print "Glyph cache misses :", value[1]
+        print "Saved command bytes:", value[2]
+
     def test_write(self):
         test_data = [2, 3, 0, 0, 3]
         print "Sending testing command"
@@ -382,11 +1050,81 @@ string_command = StringCommand([100, 100], 3, YELLOW, "HELLO")
 
 string2_command = StringCommand([10, 200], 3, GREEN, "TESTING")
 
+string3_command = StringCommand([10, 240], 1, YELLOW, "Smooth text", 2)
+
 image_command = ImageCommand([0, 0], "test.bmp")
 
+# test.bmp at half resolution, drawn 2x2 (a quarter of the bytes)
+scaled_image_command = ImageCommand([0, 0], "test.bmp", (2, 2))
+
+qoi_image_command = QoiImageCommand([0, 0], "test.bmp")
+
+rle_image_command = RleImageCommand([0, 0], "test.bmp")
+
+# test.bmp reduced to 16 colours (4 bpp)
+palette_image_command = PaletteImageCommand([0, 0], "test.bmp", 16)
+
+mask_command = MaskCommand([0, 0], "test.bmp", YELLOW, BLUE)
+
+# paint.bmp holds a baseline JPEG file
+jpeg_command = JpegCommand([0, 0], "paint.bmp")
+
+# 8x8 tiles (palette indices): blank, frame, checker, solid
+tiles = [[0] * 64,
+         [1 if x in (0, 7) or y in (0, 7) else 0
+          for y in range(8) for x in range(8)],
+         [2 * ((x + y) % 2) for y in range(8) for x in range(8)],
+         [3] * 64]
+tile_palette = [BLACK, WHITE, BLUE, YELLOW]
+tile_set_command = TileSetCommand(8, tiles, tile_palette)
+
+# 30x30 map, framed checker board
+tile_map_command = TileMapCommand([0, 0], 30,
+                                  [1 if c in (0, 29) or r in (0, 29) else 2
+                                   for r in range(30) for c in range(30)])
+cell_command = CellCommand([])
+
+# 32x16 atlas: box and ball (SPRITE_KEY is transparent)
+atlas = [(BLUE if 2 <= x <= 13 and 2 <= y <= 13 else YELLOW) if x < 16 else
+         (WHITE if (x - 23.5) ** 2 + (y - 7.5) ** 2 <= 49 else SPRITE_KEY)
+         for y in range(16) for x in range(32)]
+atlas_command = AtlasCommand(32, atlas)
+box_command = SpriteCommand(0, [0, 0], [16, 16], [0, 40], 0, BLACK, True)
+ball_command = SpriteCommand(1, [16, 0], [16, 16], [0, 120], 1, BLACK, True)
+move_command = MoveCommand([])
+
+# Uploads the firmware rejects, each sent with its whole payload
+# 4200x2 mask, a row is wider than the row buffer
+bad_mask_command = PayloadCommand("Mask 4200x2",
+                                  image_param(CMD_MSK, [0, 0], [4200, 2]) +
+                                  [0xff, 0xff, 0x00, 0x00, 0] + [0x55] * 1050)
+# 12x12 tiles (8x8 and 16x16 only)
+bad_tile_set_command = TileSetCommand(12, tiles, tile_palette)
+# Map that does not fit the screen
+bad_tile_map_command = TileMapCommand([200, 200], 30, [1] * 900)
+# 64x64 RGB565 atlas, larger than the atlas memory
+bad_atlas_command = AtlasCommand(64, [RED] * 64 * 64)
+
 data_list = []
 raw_command = RawCommand(0x01, data_list)
 
+frame_begin_command = FrameCommand(True)
+frame_end_command = FrameCommand(False)
+
+status_command = StatusCommand()
+
+terminal_command = TerminalCommand()
+
+chart_command = ChartCommand()
+
+scope_command = ScopeCommand()
+
+field_command = FieldCommand(0, [10, 20], 3, WHITE, BLACK, 6, FLD_RIGHT)
+number_command = NumberCommand(0, 0)
+
+# Asset 0 of the Makefile ASSETS list
+asset_command = AssetCommand(0, [0, 0])
+
 pos_list = [[0, 0], [100, 100], [190, 270]]
 sqb_command = SqbCommand([0, 0], [50, 50], WHITE, pos_list)
 
@@ -407,12 +1145,70 @@ def block_action():
 def string_action():
     dev.send(string_command)
     dev.send(string2_command)
+    dev.send(string3_command)
 
 
 def image_action():
     dev.send(image_command)
 
 
+def scaled_image_action():
+    dev.send(scaled_image_command)
+
+
+def qoi_image_action():
+    dev.send(qoi_image_command)
+
+
+def rle_image_action():
+    dev.send(rle_image_command)
+
+
+def palette_image_action():
+    dev.send(palette_image_command)
+
+
+def mask_action():
+    mask_command.set_param([0, 0], "test.bmp", YELLOW, BLUE)
+    dev.send(mask_command)
+    mask_command.set_param([20, 20], "test.bmp", RED, BLACK, True)
+    dev.send(mask_command)
+
+
+def jpeg_action():
+    dev.send(jpeg_command)
+
+
+def tile_action():
+    dev.send(tile_set_command)
+    dev.send(tile_map_command)
+    for col in range(1, 29):
+        cell_command.set_param([(col - 1, 15, 2), (col, 15, 3)])
+        dev.send(cell_command)
+        time.sleep(0.05)
+
+
+def sprite_action():
+    dev.send(atlas_command)
+    dev.send(box_command)
+    dev.send(ball_command)
+    for i in range(150):
+        move_command.set_param([(0, i, 40 + i // 4), (1, 2 * i, 120 - i // 4)])
+        dev.send(move_command)
+        time.sleep(0.02)
+
+
+def reject_action():
+    # The payload of a rejected upload is skipped, the block drawn last
+    # only appears if the parser kept in step
+    clear_action()
+    dev.send(bad_mask_command)
+    dev.send(bad_tile_set_command)
+    dev.send(bad_tile_map_command)
+    dev.send(bad_atlas_command)
+    dev.send(block_command)
+
+
 def raw_action():
     data = [0, 0, 0, 100]
     raw_command.set_param(0x2A, data)
@@ -432,6 +1228,62 @@ def sqb_action():
     dev.send(sqb_command)
 
 
+def frame_action():
+    dev.send(frame_begin_command)
+    dev.send(block_command)
+    dev.send(block2_command)
+    dev.send(string_command)
+    dev.send(string2_command)
+    dev.send(frame_end_command)
+
+
+def terminal_action():
+    terminal_command.start(0, 0, 2, GREEN, BLACK)
+    dev.send(terminal_command)
+    for i in range(40):
+        terminal_command.write("Line " + str(i) + "\n")
+        dev.send(terminal_command)
+        time.sleep(0.1)
+
+
+def chart_action():
+    chart_command.register(0, [20, 60], [200, 100], [-100, 100], GREEN, BLACK)
+    dev.send(chart_command)
+    for i in range(400):
+        value = int(90 * math.sin(i / 10.0))
+        chart_command.samples(0, [value])
+        dev.send(chart_command)
+        time.sleep(0.02)
+
+
+def scope_action():
+    scope_command.register(0, [20, 180], [200, 100], [0, 255], YELLOW, BLACK)
+    dev.send(scope_command)
+    for frame in range(100):
+        values = [int(127 + 120 * math.sin((i + frame * 4) / 12.0))
+                  for i in range(200)]
+        scope_command.trace(0, values)
+        dev.send(scope_command)
+        time.sleep(0.05)
+
+
+def number_action():
+    dev.send(field_command)
+    for value in range(-50, 1000, 7):
+        number_command.set_param(0, value)
+        dev.send(number_command)
+        time.sleep(0.02)
+
+
+def asset_action():
+    dev.send(asset_command)
+
+
+def status_action():
+    dev.send(status_command)
+    dev.read_status()
+
+
 def test_action():
     clear_action()
     time.sleep(0.5)
@@ -457,7 +1309,23 @@ action_map = {
     'b': block_action,
     't': string_action,
     'i': image_action,
+    'g': scaled_image_action,
+    'q': qoi_image_action,
+    'e': rle_image_action,
+    'p': palette_image_action,
+    'm': mask_action,
+    'j': jpeg_action,
+    'k': tile_action,
+    'd': sprite_action,
+    'z': reject_action,
     'r': raw_action,
+    'f': frame_action,
+    'u': status_action,
+    'l': terminal_action,
+    'h': chart_action,
+    'o': scope_action,
+    'n': number_action,
+    'a': asset_action,
     's': sqb_action,
     '`': test_action,
 }
@@ -475,8 +1343,24 @@ while (True):
     print "c - Clear Display"
     print "b - Send Block"
     print "t - Send Text"
-    print "i - Send Image"
+    print "i - Image"
+    print "g - Send Scaled Image"
+    print "q - Send QOI Image"
+    print "e - Send RLE Image"
+    print "p - Send Indexed Image"
+    print "m - Send Mask"
+    print "j - Send JPEG"
+    print "k - Tile Map"
+    print "d - Sprites"
+    print "z - Rejected Uploads"
     print "r - Send Raw"
+    print "f - Send Frame (display list)"
+    print "u - Read Status"
+    print "l - Terminal Log"
+    print "h - Strip Chart"
+    print "o - Oscilloscope"
+    print "n - Numeric Field"
+    print "a - Flash Asset"
     print "s - Send Repeated Block"
     print "` - Test Program"
     print "x - Exit"
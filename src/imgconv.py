@@ -0,0 +1,206 @@
+# =============================================================================
+#    Image Asset Generator
+#
+#    Converts images into RGB565 arrays linked into flash, so tft.c can blit
+#    them by asset ID (tft_blit_asset) instead of receiving every pixel over
+#    UART. Every image is stored raw or run-length encoded.
+#
+#    Image sources:
+#        file.bmp[:rle]          Uncompressed 24/32-bit or 1/4/8-bit indexed
+#                                BMP (read without PIL)
+#        file.png[:rle]          Any other format PIL can open
+#
+#    RLE stream (16-bit words, tokens never cross a row):
+#        0x8000 | n, colour      n pixels of colour (run)
+#        n, pixel * n            n pixels copied as they are (literal)
+#
+#    Asset IDs are 0, 1... in the order given.
+#
+#    Usage: python3 imgconv.py asset_tables.h source...
+# =============================================================================
+
+import os
+import struct
+import sys
+
+# =============================================================================
+#    Definition
+# =============================================================================
+
+# Run token flag (TFT_ASSET_RUN in tft.h)
+ASSET_RUN = 0x8000
+
+# Longest token
+MAX_COUNT = 0x7FFF
+
+# Shortest run worth a token, shorter runs stay in the literal
+MIN_RUN = 3
+
+# =============================================================================
+#    Helper Function
+# =============================================================================
+
+
+def convert_16_bit_color(r, g, b):
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+def read_bmp(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if data[:2] != b"BM":
+        return None
+
+    offset, = struct.unpack_from("<I", data, 10)
+    width, height, planes, bpp, compression = \
+        struct.unpack_from("<iiHHI", data, 18)
+
+    if compression != 0 or bpp not in (1, 4, 8, 24, 32):
+        return None
+
+    # Palette (BGRx) follows the info header
+    palette = []
+    if bpp <= 8:
+        header_size, = struct.unpack_from("<I", data, 14)
+        colors, = struct.unpack_from("<I", data, 46)
+        for i in range(colors or (1 << bpp)):
+            b, g, r = struct.unpack_from("<BBB", data, 14 + header_size + 4 * i)
+            palette.append((r, g, b))
+
+    # Rows are padded to 4 bytes, bottom-up unless the height is negative
+    stride = ((width * bpp + 31) // 32) * 4
+    rows = []
+    for y in range(abs(height)):
+        line = offset + y * stride
+        row = []
+        for x in range(width):
+            if bpp == 24 or bpp == 32:
+                b, g, r = struct.unpack_from("<BBB", data, line + x * bpp // 8)
+            else:
+                bit = x * bpp
+                index = (data[line + bit // 8] >> (8 - bpp - bit % 8)) & ((1 << bpp) - 1)
+                r, g, b = palette[index]
+            row.append(convert_16_bit_color(r, g, b))
+        rows.append(row)
+
+    if height > 0:
+        rows.reverse()
+
+    return rows
+
+
+def read_image(path):
+    rows = read_bmp(path)
+
+    if rows is None:
+        from PIL import Image
+
+        img = Image.open(path).convert("RGB")
+        pixels = list(img.getdata())
+        width = img.size[0]
+        rows = [[convert_16_bit_color(*p) for p in pixels[y:y + width]]
+                for y in range(0, len(pixels), width)]
+
+    return rows
+
+
+def encode_rle(rows):
+    words = []
+
+    for row in rows:
+        literal = []
+        x = 0
+        while x < len(row):
+            n = 1
+            while x + n < len(row) and row[x + n] == row[x] and n < MAX_COUNT:
+                n += 1
+
+            if n >= MIN_RUN:
+                if literal:
+                    words += [len(literal)] + literal
+                    literal = []
+                words += [ASSET_RUN | n, row[x]]
+            else:
+                for pixel in row[x:x + n]:
+                    if len(literal) == MAX_COUNT:
+                        words += [len(literal)] + literal
+                        literal = []
+                    literal.append(pixel)
+            x += n
+
+        if literal:
+            words += [len(literal)] + literal
+
+    return words
+
+
+def load(source):
+    path, _, option = source.partition(":")
+
+    if option not in ("", "rle"):
+        raise ValueError(source + ": unknown option " + option)
+
+    rows = read_image(path)
+    width, height = len(rows[0]), len(rows)
+
+    if width > 0xFFFF or height > 0xFFFF:
+        raise ValueError(source + ": image too large")
+
+    if option == "rle":
+        return os.path.basename(path), width, height, "TFT_ASSET_RLE", encode_rle(rows)
+
+    return os.path.basename(path), width, height, "TFT_ASSET_RAW", \
+        [pixel for row in rows for pixel in row]
+
+
+# =============================================================================
+#    Main Program
+# =============================================================================
+
+
+def main(dst, sources):
+    assets = [load(source) for source in sources]
+
+    out = []
+    out.append("/*")
+    out.append(" * Generated by imgconv.py - do not edit")
+    for i, (name, width, height, fmt, words) in enumerate(assets):
+        out.append(" * Asset %d: %s, %dx%d, %s, %d bytes"
+                   % (i, name, width, height, fmt, 2 * len(words)))
+    out.append(" */")
+    out.append("")
+    out.append("#ifndef ASSET_TABLES_H")
+    out.append("#define ASSET_TABLES_H")
+    out.append("")
+    out.append("#define ASSET_TABLE_COUNT       (%dU)" % len(assets))
+    out.append("")
+
+    for i, (name, width, height, fmt, words) in enumerate(assets):
+        out.append("static const uint16_t asset_%d_data[%d] =" % (i, len(words)))
+        out.append("{")
+        for j in range(0, len(words), 10):
+            out.append("    " + ", ".join("0x%04X" % v for v in words[j:j + 10]) + ",")
+        out[-1] = out[-1].rstrip(",")
+        out.append("};")
+        out.append("")
+
+    if assets:
+        out.append("/* width, height, format, data */")
+        out.append("static const tft_asset_t asset_table[ASSET_TABLE_COUNT] =")
+        out.append("{")
+        for i, (name, width, height, fmt, words) in enumerate(assets):
+            out.append("    {%d, %d, %s, asset_%d_data},"
+                       % (width, height, fmt, i))
+        out[-1] = out[-1].rstrip(",")
+        out.append("};")
+        out.append("")
+
+    out.append("#endif")
+
+    with open(dst, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main(sys.argv[1], sys.argv[2:])
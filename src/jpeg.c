@@ -0,0 +1,1138 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  jpeg.c
+ *
+ *    Description:  Baseline JPEG streaming decoder implementation file
+ *                  Small footprint decoder in the TJpgDec style: baseline
+ *                  Huffman, 8-bit, greyscale or YCbCr with 4:4:4, 4:2:2 or
+ *                  4:2:0 sampling, restart markers. Progressive and
+ *                  arithmetic coded files are refused.
+ *
+ *                  Bytes are fed one at a time as they arrive and kept in a
+ *                  small input buffer. Header segments are parsed once they
+ *                  are complete in the buffer. MCUs are decoded as soon as
+ *                  enough bytes are buffered: an MCU that runs out of input
+ *                  is rolled back and decoded again when more bytes arrived.
+ *                  Every MCU is drawn in its own window. The decoder
+ *                  state is kept in the scratch memory for the duration of
+ *                  an image.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 11:05:27 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "jpeg.h"
+#include "tft.h"
+#include "scratch.h"
+#include "setting.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* Markers */
+#define JPEG_SOF0           (0xC0U)
+#define JPEG_SOF1           (0xC1U)
+#define JPEG_DHT            (0xC4U)
+#define JPEG_SOI            (0xD8U)
+#define JPEG_EOI            (0xD9U)
+#define JPEG_SOS            (0xDAU)
+#define JPEG_DQT            (0xDBU)
+#define JPEG_DRI            (0xDDU)
+#define JPEG_RST0           (0xD0U)
+#define JPEG_TEM            (0x01U)
+
+/* Largest number of Huffman values (AC table) */
+#define JPEG_HUFF_VALUES    (162U)
+
+/* Largest MCU (2x2 luma blocks) */
+#define JPEG_MCU_SIZE       (16U)
+
+/* Input bytes to wait for before an MCU that ran out is decoded again */
+#define JPEG_RETRY_BYTES    (64U)
+
+/* Fixed point (12 bits) IDCT constant */
+#define FIX(x)              ((int32_t)((x) * 4096 + 0.5))
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+typedef enum
+{
+    JPEG_STATE_MARKER = 0,
+    JPEG_STATE_SKIP,
+    JPEG_STATE_SCAN,
+    JPEG_STATE_DONE,
+    JPEG_STATE_ERROR
+} jpeg_state_t;
+
+/* Huffman table (canonical codes, decoded one bit at a time) */
+typedef struct
+{
+    /* Largest code of length l + 1 (-1 if none) */
+    int32_t  maxcode[16];
+
+    /* First code of length l + 1 and index of its value */
+    uint16_t mincode[16];
+    uint8_t  valptr[16];
+
+    uint8_t  values[JPEG_HUFF_VALUES];
+} jpeg_huffman_t;
+
+typedef struct
+{
+    uint8_t  id;
+
+    /* Sampling factors */
+    uint8_t  h;
+    uint8_t  v;
+
+    /* Quantisation, DC and AC Huffman table */
+    uint8_t  tq;
+    uint8_t  td;
+    uint8_t  ta;
+
+    /* DC predictor */
+    int16_t  dc;
+} jpeg_component_t;
+
+/* Decoding position, saved before every MCU */
+typedef struct
+{
+    uint16_t pos;
+    uint32_t bits;
+    uint8_t  bit_count;
+    uint16_t restarts_left;
+    int16_t  dc[3];
+} jpeg_mark_t;
+
+typedef struct
+{
+    jpeg_state_t     state;
+
+    /* Input bytes, [pos, used) are not processed yet */
+    uint8_t          input[JPEG_INPUT_SIZE];
+    uint16_t         pos;
+    uint16_t         used;
+
+    /* Unprocessed bytes needed before processing is tried again */
+    uint16_t         wanted;
+
+    /* Bytes of an ignored segment still to be skipped */
+    uint16_t         skip;
+
+    /* All input has been fed, missing bits read as zero */
+    bool             final;
+
+    /* Bit reader */
+    uint32_t         bits;
+    uint8_t          bit_count;
+    bool             underrun;
+    bool             corrupt;
+
+    /* Quantisation tables (zigzag order) */
+    uint8_t          quant[4][64];
+
+    /* Huffman tables [DC, AC][0, 1] */
+    jpeg_huffman_t   huffman[2][2];
+
+    /* Frame */
+    jpeg_component_t component[3];
+    uint8_t          components;
+    uint16_t         width;
+    uint16_t         height;
+    uint8_t          mcu_width;
+    uint8_t          mcu_height;
+
+    /* Image position of the next MCU */
+    uint16_t         mcu_x;
+    uint16_t         mcu_y;
+
+    /* MCUs between restart markers (0 if none) and MCUs left until next */
+    uint16_t         restart_interval;
+    uint16_t         restarts_left;
+
+    /* Screen position of the top left corner */
+    uint16_t         x;
+    uint16_t         y;
+
+    /* Samples of the MCU */
+    uint8_t          luma[JPEG_MCU_SIZE * JPEG_MCU_SIZE];
+    uint8_t          chroma[2][64];
+
+    /* Coefficients of the block being decoded (kept off the small stack) */
+    int32_t          coef[64];
+
+    /* Output rows, one is filled while uDMA may still send the other */
+    uint16_t         line[2][JPEG_MCU_SIZE];
+    uint8_t          line_index;
+} jpeg_info_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+/* Decoder state, in the scratch memory from jpeg_begin */
+static jpeg_info_t *jpeg_info;
+
+/* Natural (row-major) index of each zigzag position */
+static const uint8_t zigzag[64] =
+{
+     0,  1,  8, 16,  9,  2,  3, 10,
+    17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34,
+    27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36,
+    29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46,
+    53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Big-endian 16-bit value
+ * @param   p   First byte
+ * @return  Value
+ */
+static uint16_t get_word(const uint8_t *p)
+{
+    return convert_to_word(p[0], p[1]);
+}
+
+/**
+ * @brief   Limit a sample to 0 - 255
+ * @param   value   Sample
+ * @return  Limited sample
+ */
+static uint8_t clamp(int32_t value)
+{
+    return (uint8_t)constrain(value, 0, 255);
+}
+
+/**
+ * @brief   Read the next bit of entropy-coded data
+ *          0xFF 0x00 is a 0xFF data byte. At a marker, or past the end of
+ *          the input once it is final, zero bits are read. Before that an
+ *          exhausted input sets underrun
+ * @return  Bit
+ */
+static uint8_t get_bit(void)
+{
+    jpeg_info_t *info = jpeg_info;
+    uint8_t byte = 0;
+
+    if (info->bit_count == 0)
+    {
+        if ((info->pos >= info->used) ||
+            ((info->input[info->pos] == 0xFF) && (info->pos + 1 >= info->used)))
+        {
+            info->underrun = !info->final;
+        }
+        else if (info->input[info->pos] != 0xFF)
+        {
+            byte = info->input[info->pos++];
+        }
+        else if (info->input[info->pos + 1] == 0x00)
+        {
+            byte = 0xFF;
+            info->pos += 2;
+        }
+
+        info->bits = byte;
+        info->bit_count = 8;
+    }
+
+    info->bit_count--;
+
+    return (info->bits >> info->bit_count) & 0x01;
+}
+
+/**
+ * @brief   Read a value and extend its sign (F.2.2.1)
+ * @param   size    Number of bits (0 - 15)
+ * @return  Value
+ */
+static int32_t get_value(uint8_t size)
+{
+    int32_t value = 0;
+    uint8_t i;
+
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < size; i++)
+    {
+        value = (value << 1) | get_bit();
+    }
+
+    if (value < (1L << (size - 1)))
+    {
+        value += 1 - (1L << size);
+    }
+
+    return value;
+}
+
+/**
+ * @brief   Decode one Huffman code (F.2.2.3)
+ * @param   table   Huffman table
+ * @return  Value of the code
+ */
+static uint8_t huffman_decode(const jpeg_huffman_t *table)
+{
+    int32_t code = 0;
+    uint8_t l;
+
+    for (l = 0; l < 16; l++)
+    {
+        code = (code << 1) | get_bit();
+
+        if (code <= table->maxcode[l])
+        {
+            return table->values[table->valptr[l] + code - table->mincode[l]];
+        }
+    }
+
+    jpeg_info->corrupt = true;
+
+    return 0;
+}
+
+/**
+ * @brief   Inverse DCT of a dequantised block (integer Loeffler, as the
+ *          IJG islow method)
+ *          The column pass is done in place, coef is overwritten
+ * @param   coef    Coefficients (row-major)
+ * @param   out     Output samples
+ * @param   stride  Output row length
+ */
+static void idct(int32_t *coef, uint8_t *out, uint8_t stride)
+{
+    int32_t s[8];
+    int32_t t0, t1, t2, t3;
+    int32_t x0, x1, x2, x3;
+    int32_t p1, p2, p3, p4, p5;
+    uint8_t pass, i, j;
+    int32_t *w;
+
+    for (pass = 0; pass < 2; pass++)
+    {
+        for (i = 0; i < 8; i++)
+        {
+            /* Columns of the coefficients, then rows of the first pass */
+            for (j = 0; j < 8; j++)
+            {
+                s[j] = (pass == 0) ? coef[j * 8 + i] : coef[i * 8 + j];
+            }
+
+            p1 = (s[2] + s[6]) * FIX(0.5411961);
+            t2 = p1 + s[6] * FIX(-1.847759065);
+            t3 = p1 + s[2] * FIX(0.765366865);
+            t0 = (s[0] + s[4]) * 4096;
+            t1 = (s[0] - s[4]) * 4096;
+
+            x0 = t0 + t3;
+            x3 = t0 - t3;
+            x1 = t1 + t2;
+            x2 = t1 - t2;
+
+            p3 = s[7] + s[3];
+            p4 = s[5] + s[1];
+            p1 = s[7] + s[1];
+            p2 = s[5] + s[3];
+            p5 = (p3 + p4) * FIX(1.175875602);
+
+            t0 = s[7] * FIX(0.298631336);
+            t1 = s[5] * FIX(2.053119869);
+            t2 = s[3] * FIX(3.072711026);
+            t3 = s[1] * FIX(1.501321110);
+            p1 = p5 + p1 * FIX(-0.899976223);
+            p2 = p5 + p2 * FIX(-2.562915447);
+            p3 = p3 * FIX(-1.961570560);
+            p4 = p4 * FIX(-0.390180644);
+
+            t3 += p1 + p4;
+            t2 += p2 + p3;
+            t1 += p2 + p4;
+            t0 += p1 + p3;
+
+            if (pass == 0)
+            {
+                /* Keep 2 fraction bits for the second pass */
+                w = &coef[i];
+                x0 += 512;
+                x1 += 512;
+                x2 += 512;
+                x3 += 512;
+
+                w[0]  = (x0 + t3) >> 10;
+                w[56] = (x0 - t3) >> 10;
+                w[8]  = (x1 + t2) >> 10;
+                w[48] = (x1 - t2) >> 10;
+                w[16] = (x2 + t1) >> 10;
+                w[40] = (x2 - t1) >> 10;
+                w[24] = (x3 + t0) >> 10;
+                w[32] = (x3 - t0) >> 10;
+            }
+            else
+            {
+                /* Round and level shift (+128) */
+                x0 += 65536 + (128L << 17);
+                x1 += 65536 + (128L << 17);
+                x2 += 65536 + (128L << 17);
+                x3 += 65536 + (128L << 17);
+
+                out[0] = clamp((x0 + t3) >> 17);
+                out[7] = clamp((x0 - t3) >> 17);
+                out[1] = clamp((x1 + t2) >> 17);
+                out[6] = clamp((x1 - t2) >> 17);
+                out[2] = clamp((x2 + t1) >> 17);
+                out[5] = clamp((x2 - t1) >> 17);
+                out[3] = clamp((x3 + t0) >> 17);
+                out[4] = clamp((x3 - t0) >> 17);
+
+                out += stride;
+            }
+        }
+    }
+}
+
+/**
+ * @brief   Decode one block of a component
+ * @param   c       Component index
+ * @param   out     Output samples
+ * @param   stride  Output row length
+ */
+static void decode_block(uint8_t c, uint8_t *out, uint8_t stride)
+{
+    jpeg_component_t *component = &jpeg_info->component[c];
+    const uint8_t *quant = &jpeg_info->quant[component->tq][0];
+    int32_t *coef = &jpeg_info->coef[0];
+    uint8_t k;
+    uint8_t rs;
+
+    /* The MCU is decoded again once more input arrived */
+    if (jpeg_info->underrun)
+    {
+        return;
+    }
+
+    memset(coef, 0, sizeof(jpeg_info->coef));
+
+    /* DC difference */
+    rs = huffman_decode(&jpeg_info->huffman[0][component->td]);
+
+    if (jpeg_info->underrun)
+    {
+        return;
+    }
+
+    if (rs > 11)
+    {
+        jpeg_info->corrupt = true;
+        return;
+    }
+
+    component->dc += get_value(rs);
+    coef[0] = (int32_t)component->dc * quant[0];
+
+    /* AC run/size codes */
+    for (k = 1; k < 64; k++)
+    {
+        rs = huffman_decode(&jpeg_info->huffman[1][component->ta]);
+
+        /* Zero bits read past the input are not data */
+        if (jpeg_info->underrun)
+        {
+            return;
+        }
+
+        if ((rs & 0x0f) == 0)
+        {
+            /* End of block, or 16 zeros (ZRL) */
+            if (rs != 0xF0)
+            {
+                break;
+            }
+
+            k += 15;
+            continue;
+        }
+
+        k += rs >> 4;
+
+        if (k > 63)
+        {
+            jpeg_info->corrupt = true;
+            return;
+        }
+
+        coef[zigzag[k]] = get_value(rs & 0x0f) * quant[k];
+    }
+
+    idct(coef, out, stride);
+}
+
+/**
+ * @brief   Convert a YCbCr sample to RGB565
+ * @param   y   Luma
+ * @param   cb  Blue difference
+ * @param   cr  Red difference
+ * @return  Colour (16-bit)
+ */
+static uint16_t ycc_to_color(int32_t y, int32_t cb, int32_t cr)
+{
+    uint8_t r, g, b;
+
+    cb -= 128;
+    cr -= 128;
+
+    /* 1.402, 0.344136, 0.714136 and 1.772 in 16.16 fixed point */
+    r = clamp(y + ((cr * 91881 + 32768) >> 16));
+    g = clamp(y - ((cb * 22554 + cr * 46802 - 32768) >> 16));
+    b = clamp(y + ((cb * 116130 + 32768) >> 16));
+
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+}
+
+/**
+ * @brief   Draw the decoded MCU in its own window
+ *          Clipped to the image and to the screen, sent row by row so
+ *          each row is converted while uDMA sends the previous one
+ */
+static void draw_mcu(void)
+{
+    jpeg_info_t *info = jpeg_info;
+    uint32_t x0 = (uint32_t)info->x + info->mcu_x;
+    uint32_t y0 = (uint32_t)info->y + info->mcu_y;
+    uint16_t width;
+    uint16_t height;
+    uint16_t *line;
+    uint8_t  row, col;
+    uint8_t  shift_x = info->component[0].h - 1;
+    uint8_t  shift_y = info->component[0].v - 1;
+    uint8_t  luma;
+    uint8_t  c;
+
+    if ((x0 >= tft_get_width()) || (y0 >= tft_get_height()))
+    {
+        return;
+    }
+
+    width = min(info->mcu_width, info->width - info->mcu_x);
+    width = min(width, tft_get_width() - x0);
+    height = min(info->mcu_height, info->height - info->mcu_y);
+    height = min(height, tft_get_height() - y0);
+
+    for (row = 0; row < height; row++)
+    {
+        line = &info->line[info->line_index][0];
+        info->line_index ^= 1;
+
+        for (col = 0; col < width; col++)
+        {
+            luma = info->luma[row * JPEG_MCU_SIZE + col];
+
+            if (info->components == 1)
+            {
+                line[col] = ((luma >> 3) << 11) | ((luma >> 2) << 5) | (luma >> 3);
+            }
+            else
+            {
+                /* Chroma is upsampled by repeating samples */
+                c = (row >> shift_y) * 8 + (col >> shift_x);
+
+                line[col] = ycc_to_color(luma, info->chroma[0][c],
+                                         info->chroma[1][c]);
+            }
+        }
+
+        tft_write_pixels(x0, y0, x0 + width - 1, y0 + height - 1,
+                         line, width);
+    }
+}
+
+/**
+ * @brief   Decode and draw the next MCU
+ *          Restores the position before the MCU if the input ran out
+ * @return  False if the input ran out or the data is corrupt
+ */
+static bool decode_mcu(void)
+{
+    jpeg_info_t *info = jpeg_info;
+    jpeg_mark_t mark;
+    uint8_t bx, by;
+    uint8_t c;
+
+    mark.pos = info->pos;
+    mark.bits = info->bits;
+    mark.bit_count = info->bit_count;
+    mark.restarts_left = info->restarts_left;
+
+    for (c = 0; c < info->components; c++)
+    {
+        mark.dc[c] = info->component[c].dc;
+    }
+
+    info->underrun = false;
+    info->corrupt = false;
+
+    if (info->restart_interval > 0)
+    {
+        if (info->restarts_left == 0)
+        {
+            /* Byte aligned RSTn marker, predictors start again */
+            info->bit_count = 0;
+
+            if (info->used - info->pos < 2)
+            {
+                info->underrun = !info->final;
+            }
+            else if ((info->input[info->pos] == 0xFF) &&
+                     ((info->input[info->pos + 1] & 0xF8) == JPEG_RST0))
+            {
+                info->pos += 2;
+            }
+
+            for (c = 0; c < info->components; c++)
+            {
+                info->component[c].dc = 0;
+            }
+
+            info->restarts_left = info->restart_interval;
+        }
+
+        info->restarts_left--;
+    }
+
+    if (info->components == 1)
+    {
+        decode_block(0, &info->luma[0], JPEG_MCU_SIZE);
+    }
+    else
+    {
+        for (by = 0; by < info->component[0].v; by++)
+        {
+            for (bx = 0; bx < info->component[0].h; bx++)
+            {
+                decode_block(0, &info->luma[by * 8 * JPEG_MCU_SIZE + bx * 8],
+                             JPEG_MCU_SIZE);
+            }
+        }
+
+        decode_block(1, &info->chroma[0][0], 8);
+        decode_block(2, &info->chroma[1][0], 8);
+    }
+
+    if (info->underrun || info->corrupt)
+    {
+        info->pos = mark.pos;
+        info->bits = mark.bits;
+        info->bit_count = mark.bit_count;
+        info->restarts_left = mark.restarts_left;
+
+        for (c = 0; c < info->components; c++)
+        {
+            info->component[c].dc = mark.dc[c];
+        }
+
+        return false;
+    }
+
+    draw_mcu();
+
+    info->mcu_x += info->mcu_width;
+
+    if (info->mcu_x >= info->width)
+    {
+        info->mcu_x = 0;
+        info->mcu_y += info->mcu_height;
+    }
+
+    return true;
+}
+
+/**
+ * @brief   Parse a DQT segment (8-bit tables only)
+ * @param   p       Segment payload
+ * @param   length  Payload length
+ * @return  False if the segment is not supported
+ */
+static bool parse_dqt(const uint8_t *p, uint16_t length)
+{
+    while (length >= 65)
+    {
+        /* Precision 0 (8-bit), table 0 - 3 */
+        if (p[0] > 3)
+        {
+            return false;
+        }
+
+        memcpy(&jpeg_info->quant[p[0]][0], &p[1], 64);
+
+        p += 65;
+        length -= 65;
+    }
+
+    return (length == 0);
+}
+
+/**
+ * @brief   Parse a DHT segment
+ * @param   p       Segment payload
+ * @param   length  Payload length
+ * @return  False if the segment is not supported
+ */
+static bool parse_dht(const uint8_t *p, uint16_t length)
+{
+    jpeg_huffman_t *table;
+    uint16_t count;
+    uint16_t code;
+    uint8_t  l;
+
+    while (length >= 17)
+    {
+        /* Class 0 (DC) or 1 (AC), table 0 - 1 (baseline) */
+        if (((p[0] >> 4) > 1) || ((p[0] & 0x0f) > 1))
+        {
+            return false;
+        }
+
+        table = &jpeg_info->huffman[p[0] >> 4][p[0] & 0x0f];
+
+        count = 0;
+        code = 0;
+
+        for (l = 0; l < 16; l++)
+        {
+            table->valptr[l] = count;
+            table->mincode[l] = code;
+
+            count += p[1 + l];
+            code += p[1 + l];
+
+            table->maxcode[l] = (p[1 + l] > 0) ? (int32_t)code - 1 : -1;
+
+            code <<= 1;
+        }
+
+        if ((count > JPEG_HUFF_VALUES) || (length < 17 + count))
+        {
+            return false;
+        }
+
+        memcpy(&table->values[0], &p[17], count);
+
+        p += 17 + count;
+        length -= 17 + count;
+    }
+
+    return (length == 0);
+}
+
+/**
+ * @brief   Parse a SOF0 or SOF1 segment
+ *          Greyscale, or YCbCr with luma sampling 1x1, 2x1, 1x2 or 2x2
+ *          and chroma 1x1
+ * @param   p       Segment payload
+ * @param   length  Payload length
+ * @return  False if the frame is not supported
+ */
+static bool parse_sof(const uint8_t *p, uint16_t length)
+{
+    jpeg_info_t *info = jpeg_info;
+    jpeg_component_t *component;
+    uint8_t c;
+
+    if ((length < 6) || (p[0] != 8) || ((p[5] != 1) && (p[5] != 3)) ||
+        (length != 6 + 3 * p[5]))
+    {
+        return false;
+    }
+
+    info->height = get_word(&p[1]);
+    info->width = get_word(&p[3]);
+    info->components = p[5];
+
+    for (c = 0; c < info->components; c++)
+    {
+        component = &info->component[c];
+
+        component->id = p[6 + 3 * c];
+        component->h = p[7 + 3 * c] >> 4;
+        component->v = p[7 + 3 * c] & 0x0f;
+        component->tq = p[8 + 3 * c] & 0x03;
+
+        if (info->components == 1)
+        {
+            /* A single component scan is 8x8 blocks whatever the factors */
+            component->h = 1;
+            component->v = 1;
+        }
+        else if (((c == 0) && ((component->h < 1) || (component->h > 2) ||
+                               (component->v < 1) || (component->v > 2))) ||
+                 ((c > 0) && ((component->h != 1) || (component->v != 1))))
+        {
+            return false;
+        }
+    }
+
+    info->mcu_width = 8 * info->component[0].h;
+    info->mcu_height = 8 * info->component[0].v;
+
+    /* Height defined later (DNL) is not supported */
+    return (info->width > 0) && (info->height > 0);
+}
+
+/**
+ * @brief   Parse a SOS segment and start the scan
+ *          The scan must hold every component (interleaved, baseline)
+ * @param   p       Segment payload
+ * @param   length  Payload length
+ * @return  False if the scan is not supported
+ */
+static bool parse_sos(const uint8_t *p, uint16_t length)
+{
+    jpeg_info_t *info = jpeg_info;
+    uint8_t i, c;
+
+    if ((info->components == 0) || (p[0] != info->components) ||
+        (length != 4 + 2 * p[0]))
+    {
+        return false;
+    }
+
+    for (i = 0; i < p[0]; i++)
+    {
+        for (c = 0; (c < info->components) &&
+                    (info->component[c].id != p[1 + 2 * i]); c++);
+
+        if ((c == info->components) ||
+            ((p[2 + 2 * i] >> 4) > 1) || ((p[2 + 2 * i] & 0x0f) > 1))
+        {
+            return false;
+        }
+
+        info->component[c].td = p[2 + 2 * i] >> 4;
+        info->component[c].ta = p[2 + 2 * i] & 0x0f;
+        info->component[c].dc = 0;
+    }
+
+    /* Spectral selection 0 - 63, no successive approximation */
+    if ((p[1 + 2 * i] != 0) || (p[2 + 2 * i] != 63) || (p[3 + 2 * i] != 0))
+    {
+        return false;
+    }
+
+    info->bit_count = 0;
+    info->mcu_x = 0;
+    info->mcu_y = 0;
+    info->restarts_left = info->restart_interval;
+
+    return true;
+}
+
+/**
+ * @brief   Parse a complete header segment
+ * @param   marker  Segment marker
+ * @param   p       Segment payload
+ * @param   length  Payload length
+ * @return  False if the segment is not supported
+ */
+static bool parse_segment(uint8_t marker, const uint8_t *p, uint16_t length)
+{
+    bool result = false;
+
+    switch (marker)
+    {
+        case JPEG_DQT:
+            result = parse_dqt(p, length);
+            break;
+
+        case JPEG_DHT:
+            result = parse_dht(p, length);
+            break;
+
+        case JPEG_SOF0:
+        case JPEG_SOF1:
+            result = parse_sof(p, length);
+            break;
+
+        case JPEG_DRI:
+            if (length == 2)
+            {
+                jpeg_info->restart_interval = get_word(p);
+                result = true;
+            }
+            break;
+
+        default:
+            result = parse_sos(p, length);
+            break;
+    }
+
+    return result;
+}
+
+/**
+ * @brief   Process the buffered input as far as possible
+ *          Sets wanted to the number of unprocessed bytes to wait for
+ */
+static void process(void)
+{
+    jpeg_info_t *info = jpeg_info;
+    uint16_t available;
+    uint16_t length;
+    uint8_t  marker;
+
+    while ((info->state != JPEG_STATE_DONE) && (info->state != JPEG_STATE_ERROR))
+    {
+        available = info->used - info->pos;
+
+        if (info->state == JPEG_STATE_SKIP)
+        {
+            length = min(info->skip, available);
+            info->pos += length;
+            info->skip -= length;
+
+            if (info->skip > 0)
+            {
+                info->wanted = 1;
+                return;
+            }
+
+            info->state = JPEG_STATE_MARKER;
+        }
+        else if (info->state == JPEG_STATE_SCAN)
+        {
+            if (info->mcu_y >= info->height)
+            {
+                /* Scan complete, the next byte is a marker */
+                info->bit_count = 0;
+                info->state = JPEG_STATE_MARKER;
+            }
+            else if (!decode_mcu())
+            {
+                /* Running out of input is not corruption */
+                if (info->corrupt && !info->underrun)
+                {
+                    info->state = JPEG_STATE_ERROR;
+                }
+
+                info->wanted = available + JPEG_RETRY_BYTES;
+                return;
+            }
+        }
+        else
+        {
+            if (available < 2)
+            {
+                info->wanted = 2;
+                return;
+            }
+
+            marker = info->input[info->pos + 1];
+
+            /* Skip anything until a marker, and fill bytes */
+            if ((info->input[info->pos] != 0xFF) || (marker == 0xFF))
+            {
+                info->pos++;
+                continue;
+            }
+
+            /* Markers without a segment */
+            if ((marker == JPEG_SOI) || (marker == JPEG_TEM) ||
+                ((marker & 0xF8) == JPEG_RST0))
+            {
+                info->pos += 2;
+                continue;
+            }
+
+            if (marker == JPEG_EOI)
+            {
+                info->pos += 2;
+                info->state = JPEG_STATE_DONE;
+                return;
+            }
+
+            /* Other SOFn are progressive, lossless or arithmetic coded */
+            if (((marker & 0xF0) == 0xC0) && (marker != JPEG_SOF0) &&
+                (marker != JPEG_SOF1) && (marker != JPEG_DHT))
+            {
+                info->state = JPEG_STATE_ERROR;
+                return;
+            }
+
+            if (available < 4)
+            {
+                info->wanted = 4;
+                return;
+            }
+
+            length = get_word(&info->input[info->pos + 2]);
+
+            if (length < 2)
+            {
+                info->state = JPEG_STATE_ERROR;
+                return;
+            }
+
+            if ((marker == JPEG_DQT) || (marker == JPEG_DHT) ||
+                (marker == JPEG_SOF0) || (marker == JPEG_SOF1) ||
+                (marker == JPEG_DRI) || (marker == JPEG_SOS))
+            {
+                if (available < 2 + length)
+                {
+                    info->wanted = 2 + length;
+                    return;
+                }
+
+                if (!parse_segment(marker, &info->input[info->pos + 4],
+                                   length - 2))
+                {
+                    info->state = JPEG_STATE_ERROR;
+                    return;
+                }
+
+                info->pos += 2 + length;
+
+                if (marker == JPEG_SOS)
+                {
+                    info->state = JPEG_STATE_SCAN;
+                }
+            }
+            else
+            {
+                /* APPn, COM... */
+                info->skip = length - 2;
+                info->pos += 4;
+                info->state = JPEG_STATE_SKIP;
+            }
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Start decoding a JPEG file
+ * @param   x   Screen x coordinate of the top left corner
+ * @param   y   Screen y coordinate of the top left corner
+ */
+void jpeg_begin(uint16_t x, uint16_t y)
+{
+    uint8_t i, j, l;
+
+    jpeg_info = scratch_claim(SCRATCH_JPEG, sizeof(jpeg_info_t));
+
+    jpeg_info->state = JPEG_STATE_MARKER;
+    jpeg_info->pos = 0;
+    jpeg_info->used = 0;
+    jpeg_info->wanted = 2;
+    jpeg_info->final = false;
+    jpeg_info->components = 0;
+    jpeg_info->restart_interval = 0;
+    jpeg_info->x = x;
+    jpeg_info->y = y;
+
+    /* A table the file does not define matches no code */
+    for (i = 0; i < 2; i++)
+    {
+        for (j = 0; j < 2; j++)
+        {
+            for (l = 0; l < 16; l++)
+            {
+                jpeg_info->huffman[i][j].maxcode[l] = -1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief   Feed the next byte of the file
+ *          Whatever can be decoded with the buffered bytes is drawn
+ * @param   byte    File byte
+ * @return  False if the file is not supported or corrupt
+ */
+bool jpeg_feed(uint8_t byte)
+{
+    jpeg_info_t *info = jpeg_info;
+
+    /* The scratch memory was taken since jpeg_begin */
+    if (scratch_owner() != SCRATCH_JPEG)
+    {
+        return false;
+    }
+
+    if ((info->state == JPEG_STATE_DONE) || (info->state == JPEG_STATE_ERROR))
+    {
+        return (info->state == JPEG_STATE_DONE);
+    }
+
+    /* Drop processed bytes */
+    if (info->used == JPEG_INPUT_SIZE)
+    {
+        memmove(&info->input[0], &info->input[info->pos],
+                info->used - info->pos);
+        info->used -= info->pos;
+        info->pos = 0;
+
+        /* A segment or an MCU does not fit in the buffer */
+        if (info->used == JPEG_INPUT_SIZE)
+        {
+            info->state = JPEG_STATE_ERROR;
+            return false;
+        }
+    }
+
+    info->input[info->used++] = byte;
+
+    if (info->used - info->pos >= info->wanted)
+    {
+        process();
+    }
+
+    return (info->state != JPEG_STATE_ERROR);
+}
+
+/**
+ * @brief   End of the file, decode what is left
+ *          Missing entropy-coded bits are taken as zero
+ * @return  False if the file is not supported or corrupt
+ */
+bool jpeg_end(void)
+{
+    if (scratch_owner() != SCRATCH_JPEG)
+    {
+        return false;
+    }
+
+    if (jpeg_info->state != JPEG_STATE_ERROR)
+    {
+        jpeg_info->final = true;
+
+        process();
+    }
+
+    return (jpeg_info->state != JPEG_STATE_ERROR);
+}
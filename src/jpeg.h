@@ -0,0 +1,39 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  jpeg.h
+ *
+ *    Description:  Baseline JPEG streaming decoder header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 11:05:27 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef JPEG_H
+#define JPEG_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+void jpeg_begin(uint16_t x, uint16_t y);
+bool jpeg_feed(uint8_t byte);
+bool jpeg_end(void);
+
+#endif
@@ -26,9 +26,18 @@
 
 /* Local includes */
 #include "spi.h"
+#include "scratch.h"
 #include "tft.h"
+#include "band.h"
+#include "dlist.h"
+#include "chart.h"
+#include "scope.h"
+#include "numfield.h"
+#include "tilemap.h"
+#include "sprite.h"
 #include "uart.h"
 #include "led.h"
+#include "evl.h"
 #include "cmd_parser.h"
 
 /*-----------------------------------------------------------------------------
@@ -45,6 +54,9 @@
  *  Private Data
  *-----------------------------------------------------------------------------*/
 
+/* Event loop services */
+static evl_services_t evl_services;
+
 /*-----------------------------------------------------------------------------
  *  Helper Functions
  *-----------------------------------------------------------------------------*/
@@ -79,9 +91,20 @@ static void peripheral_init(void)
  */
 static void service_init(void)
 {
+    /* Initialize Event Loop, polled by the main loop */
+    evl_init(&evl_services);
+
     /* Initialize SPI Component */
-    spi_init();
+    spi_init(&evl_services);
+    scratch_init();
     tft_init();
+    band_init();
+    dlist_init();
+    chart_init();
+    scope_init();
+    numfield_init();
+    tilemap_init();
+    sprite_init();
     uart_init();
     cmd_parser_init();
     led_init();
@@ -135,6 +158,7 @@ int main(void)
     {
         /* Round Robin Task Scheduler */
         uart_task();
+        evl_services.poll();
         //led_task();
     }
 }
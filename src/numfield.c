@@ -0,0 +1,220 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  numfield.c
+ *
+ *    Description:  Numeric field (diff-based number redraw) implementation
+ *                  A registered field remembers the characters it shows.
+ *                  A new value is formatted to the field width and only
+ *                  the character cells that changed are drawn, cells no
+ *                  longer used are blanked.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 09:31:18 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "numfield.h"
+#include "tft.h"
+#include "fonts.h"
+#include "setting.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* Shown in every cell when the value does not fit the field */
+#define OVERFLOW_CHAR       '#'
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    /* Field is registered */
+    bool             used;
+
+    /* Position of the first cell */
+    uint16_t         x;
+    uint16_t         y;
+
+    uint16_t         size;
+    uint16_t         fgcolor;
+    uint16_t         bgcolor;
+
+    /* Number of character cells */
+    uint8_t          width;
+    numfield_align_t align;
+
+    /* Characters shown, one per cell (' ' is a blank cell) */
+    char             text[NUMFIELD_MAX_WIDTH];
+} numfield_info_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static numfield_info_t numfield_info[NUMFIELD_COUNT];
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Format a value to the cells of a field
+ * @param   field   Field
+ * @param   value   Value
+ * @param   text    Output cells (field->width characters)
+ */
+static void format(const numfield_info_t *field, int32_t value, char *text)
+{
+    /* "-2147483648" */
+    char     digits[11];
+    uint32_t magnitude;
+    uint8_t  length = 0;
+    uint8_t  pad;
+    uint8_t  i;
+
+    magnitude = (value < 0) ? (0U - (uint32_t)value) : (uint32_t)value;
+
+    /* Digits in reverse order */
+    do
+    {
+        digits[length++] = '0' + (magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    if (value < 0)
+    {
+        digits[length++] = '-';
+    }
+
+    if (length > field->width)
+    {
+        memset(text, OVERFLOW_CHAR, field->width);
+        return;
+    }
+
+    memset(text, ' ', field->width);
+
+    pad = (field->align == NUMFIELD_RIGHT) ? (field->width - length) : 0;
+
+    for (i = 0; i < length; i++)
+    {
+        text[pad + i] = digits[length - 1 - i];
+    }
+}
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Register a numeric field and blank its cells
+ * @param   id      Field ID (0 - NUMFIELD_COUNT - 1)
+ * @param   x       x coordinate of the first cell
+ * @param   y       y coordinate
+ * @param   size    font size
+ * @param   fgcolor foreground color
+ * @param   bgcolor background color
+ * @param   width   Number of character cells (1 - NUMFIELD_MAX_WIDTH)
+ * @param   align   Alignment of the number within the cells
+ * @return  True if registered
+ */
+bool numfield_register(uint8_t id, uint16_t x, uint16_t y,
+                       uint16_t size, uint16_t fgcolor, uint16_t bgcolor,
+                       uint8_t width, numfield_align_t align)
+{
+    numfield_info_t *field;
+    uint8_t i;
+
+    if ((id >= NUMFIELD_COUNT) ||
+        (width == 0) || (width > NUMFIELD_MAX_WIDTH) ||
+        (size == 0))
+    {
+        return false;
+    }
+
+    field = &numfield_info[id];
+    field->x = x;
+    field->y = y;
+    field->size = size;
+    field->fgcolor = fgcolor;
+    field->bgcolor = bgcolor;
+    field->width = width;
+    field->align = align;
+    field->used = true;
+
+    memset(field->text, ' ', width);
+
+    for (i = 0; i < width; i++)
+    {
+        tft_draw_char_cell(' ', x + i * TFT_FONT_SPACE * size, y,
+                           size, fgcolor, bgcolor);
+    }
+
+    return true;
+}
+
+/**
+ * @brief   Show a value in a numeric field
+ *          Only the cells whose character changed are drawn
+ * @param   id      Field ID
+ * @param   value   Value
+ */
+void numfield_set(uint8_t id, int32_t value)
+{
+    numfield_info_t *field;
+    char    text[NUMFIELD_MAX_WIDTH];
+    uint8_t i;
+
+    if ((id >= NUMFIELD_COUNT) || !numfield_info[id].used)
+    {
+        return;
+    }
+
+    field = &numfield_info[id];
+
+    format(field, value, text);
+
+    for (i = 0; i < field->width; i++)
+    {
+        if (text[i] != field->text[i])
+        {
+            tft_draw_char_cell(text[i],
+                               field->x + i * TFT_FONT_SPACE * field->size,
+                               field->y, field->size,
+                               field->fgcolor, field->bgcolor);
+
+            field->text[i] = text[i];
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Numeric field initialisation
+ */
+void numfield_init(void)
+{
+    uint8_t id;
+
+    for (id = 0; id < NUMFIELD_COUNT; id++)
+    {
+        numfield_info[id].used = false;
+    }
+}
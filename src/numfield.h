@@ -0,0 +1,57 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  numfield.h
+ *
+ *    Description:  Numeric field (diff-based number redraw) header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 09:31:18 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef NUMFIELD_H
+#define NUMFIELD_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+
+/*-----------------------------------------------------------------------------
+ *  Types
+ *-----------------------------------------------------------------------------*/
+
+/* Alignment of the number within the field */
+typedef enum
+{
+    NUMFIELD_LEFT = 0,
+    NUMFIELD_RIGHT
+} numfield_align_t;
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+bool numfield_register(uint8_t id, uint16_t x, uint16_t y,
+                       uint16_t size, uint16_t fgcolor, uint16_t bgcolor,
+                       uint8_t width, numfield_align_t align);
+void numfield_set(uint8_t id, int32_t value);
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+void numfield_init(void);
+
+#endif
@@ -0,0 +1,210 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  qoi.c
+ *
+ *    Description:  QOI-style RGB565 image decoder implementation file
+ *                  The QOI operations are applied to 5-6-5 bit channels
+ *                  (see QoiImageCommand in ftdi.py for the encoder).
+ *                  Bytes are decoded one at a time as they arrive, every
+ *                  complete operation yields one colour and a pixel count.
+ *
+ *                  00iiiiii                INDEX   colour index[i]
+ *                  01rrggbb                DIFF    r, g, b += -2..1
+ *                  10gggggg rrrrbbbb       LUMA    g += -32..31,
+ *                                                  r, b += g / 2 + -8..7
+ *                  11nnnnnn (n < 62)       RUN     previous colour n + 1 times
+ *                  11111110 hhhhhhhh llllllll
+ *                                          RGB565  colour (MSB first)
+ *
+ *                  Channel arithmetic wraps (5-bit red and blue, 6-bit
+ *                  green). Every pixel is stored in the colour index at
+ *                  (r * 3 + g * 5 + b * 7) % 64. The first previous colour
+ *                  is black.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 10:12:40 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "qoi.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* Operation tags (top two bits) */
+#define QOI_OP_INDEX        (0x00U)
+#define QOI_OP_DIFF         (0x40U)
+#define QOI_OP_LUMA         (0x80U)
+#define QOI_OP_RUN          (0xC0U)
+#define QOI_OP_MASK         (0xC0U)
+
+/* Full colour operation (takes the place of run length 63) */
+#define QOI_OP_RGB565       (0xFEU)
+
+/* Colour index size */
+#define QOI_INDEX_SIZE      (64U)
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+/* Byte expected next */
+typedef enum
+{
+    QOI_STATE_OP = 0,
+    QOI_STATE_LUMA,
+    QOI_STATE_RGB_HIGH,
+    QOI_STATE_RGB_LOW
+} qoi_state_t;
+
+typedef struct
+{
+    /* Previously seen colours */
+    uint16_t    index[QOI_INDEX_SIZE];
+
+    /* Previous colour */
+    uint16_t    color;
+
+    qoi_state_t state;
+
+    /* First byte of a LUMA or RGB565 operation */
+    uint8_t     byte;
+} qoi_info_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static qoi_info_t qoi_info;
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Colour index slot of a colour
+ * @param   color   Colour (16-bit)
+ * @return  Slot (0 - QOI_INDEX_SIZE - 1)
+ */
+static uint8_t hash(uint16_t color)
+{
+    return (((color >> 11) & 0x1f) * 3 +
+            ((color >> 5) & 0x3f) * 5 +
+            (color & 0x1f) * 7) % QOI_INDEX_SIZE;
+}
+
+/**
+ * @brief   Add channel differences to the previous colour
+ * @param   dr  Red difference
+ * @param   dg  Green difference
+ * @param   db  Blue difference
+ */
+static void add_diff(int8_t dr, int8_t dg, int8_t db)
+{
+    uint16_t color = qoi_info.color;
+
+    qoi_info.color = (((((color >> 11) & 0x1f) + dr) & 0x1f) << 11) |
+                     (((((color >> 5) & 0x3f) + dg) & 0x3f) << 5) |
+                     ((((color & 0x1f) + db) & 0x1f));
+}
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Start decoding an image
+ */
+void qoi_begin(void)
+{
+    memset(&qoi_info.index[0], 0, sizeof(qoi_info.index));
+
+    qoi_info.color = 0x0000;
+    qoi_info.state = QOI_STATE_OP;
+}
+
+/**
+ * @brief   Decode the next byte of an image
+ * @param   byte    Received byte
+ * @param   color   Output: colour of the decoded pixels
+ * @return  Number of pixels of color (0 while an operation is incomplete)
+ */
+uint8_t qoi_decode(uint8_t byte, uint16_t *color)
+{
+    uint8_t count = 1;
+    int8_t  dg;
+
+    ASSERT(color != NULL);
+
+    switch (qoi_info.state)
+    {
+        case QOI_STATE_OP:
+            if (byte == QOI_OP_RGB565)
+            {
+                qoi_info.state = QOI_STATE_RGB_HIGH;
+                return 0;
+            }
+
+            switch (byte & QOI_OP_MASK)
+            {
+                case QOI_OP_INDEX:
+                    qoi_info.color = qoi_info.index[byte];
+                    break;
+
+                case QOI_OP_DIFF:
+                    add_diff(((byte >> 4) & 0x03) - 2,
+                             ((byte >> 2) & 0x03) - 2,
+                             (byte & 0x03) - 2);
+                    break;
+
+                case QOI_OP_LUMA:
+                    qoi_info.byte = byte;
+                    qoi_info.state = QOI_STATE_LUMA;
+                    return 0;
+
+                default:
+                    /* RUN (0xFF is reserved and repeats 64 times) */
+                    count = (byte & ~QOI_OP_MASK) + 1;
+                    break;
+            }
+            break;
+
+        case QOI_STATE_LUMA:
+            dg = (int8_t)(qoi_info.byte & ~QOI_OP_MASK) - 32;
+
+            add_diff(dg / 2 + (int8_t)(byte >> 4) - 8,
+                     dg,
+                     dg / 2 + (int8_t)(byte & 0x0f) - 8);
+
+            qoi_info.state = QOI_STATE_OP;
+            break;
+
+        case QOI_STATE_RGB_HIGH:
+            qoi_info.byte = byte;
+            qoi_info.state = QOI_STATE_RGB_LOW;
+            return 0;
+
+        default:
+            qoi_info.color = convert_to_word(qoi_info.byte, byte);
+            qoi_info.state = QOI_STATE_OP;
+            break;
+    }
+
+    qoi_info.index[hash(qoi_info.color)] = qoi_info.color;
+
+    *color = qoi_info.color;
+
+    return count;
+}
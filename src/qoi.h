@@ -0,0 +1,38 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  qoi.h
+ *
+ *    Description:  QOI-style RGB565 image decoder header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 10:12:40 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef QOI_H
+#define QOI_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+void qoi_begin(void);
+uint8_t qoi_decode(uint8_t byte, uint16_t *color);
+
+#endif
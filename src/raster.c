@@ -0,0 +1,455 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  raster.c
+ *
+ *    Description:  Scanline span rasteriser implementation file
+ *                  Filled shapes are cut into horizontal spans, top to
+ *                  bottom. Spans with the same extent on consecutive rows
+ *                  are merged into one block, so the output programs one
+ *                  window per block instead of one per column or pixel.
+ *                  Outlines are plotted pixel by pixel and neighbouring
+ *                  pixels on a row or column are grouped into one run.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 04:41:09 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "raster.h"
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+/* Block being merged */
+typedef struct
+{
+    /* Output of the current shape */
+    raster_block_t  block;
+
+    uint16_t        color;
+
+    /* Pending block (valid if pending) */
+    int16_t         x0;
+    int16_t         x1;
+    int16_t         y0;
+    int16_t         y1;
+    bool            pending;
+} raster_info_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static raster_info_t raster_info;
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Start a shape
+ * @param   block   Block output
+ * @param   color   Colour (16-bit)
+ */
+static void span_begin(raster_block_t block, uint16_t color)
+{
+    ASSERT(block != NULL);
+
+    raster_info.block = block;
+    raster_info.color = color;
+    raster_info.pending = false;
+}
+
+/**
+ * @brief   Send the pending block to the output
+ */
+static void span_flush(void)
+{
+    if (raster_info.pending)
+    {
+        raster_info.block(raster_info.x0, raster_info.y0,
+                          raster_info.x1, raster_info.y1,
+                          raster_info.color);
+
+        raster_info.pending = false;
+    }
+}
+
+/**
+ * @brief   Add span x0 to x1 (inclusive) of row y
+ *          Merged with the pending block if it continues it downwards
+ * @param   x0  First x coordinate
+ * @param   x1  Last x coordinate
+ * @param   y   Row
+ */
+static void span(int16_t x0, int16_t x1, int16_t y)
+{
+    if (raster_info.pending &&
+        (raster_info.x0 == x0) &&
+        (raster_info.x1 == x1) &&
+        (raster_info.y1 + 1 == y))
+    {
+        raster_info.y1 = y;
+    }
+    else
+    {
+        span_flush();
+
+        raster_info.x0 = x0;
+        raster_info.x1 = x1;
+        raster_info.y0 = y;
+        raster_info.y1 = y;
+        raster_info.pending = true;
+    }
+}
+
+/**
+ * @brief   Add pixel (x, y) of an outline
+ *          Extends the pending run if the pixel is next to either end of it
+ *          on the same row (horizontal run) or column (vertical run)
+ * @param   x   x coordinate
+ * @param   y   y coordinate
+ */
+static void plot(int16_t x, int16_t y)
+{
+    if (raster_info.pending)
+    {
+        /* Horizontal run (or single pixel) */
+        if ((raster_info.y0 == y) && (raster_info.y1 == y))
+        {
+            if (raster_info.x1 + 1 == x)
+            {
+                raster_info.x1 = x;
+                return;
+            }
+            if (raster_info.x0 - 1 == x)
+            {
+                raster_info.x0 = x;
+                return;
+            }
+        }
+
+        /* Vertical run (or single pixel) */
+        if ((raster_info.x0 == x) && (raster_info.x1 == x))
+        {
+            if (raster_info.y1 + 1 == y)
+            {
+                raster_info.y1 = y;
+                return;
+            }
+            if (raster_info.y0 - 1 == y)
+            {
+                raster_info.y0 = y;
+                return;
+            }
+        }
+    }
+
+    span_flush();
+
+    raster_info.x0 = x;
+    raster_info.x1 = x;
+    raster_info.y0 = y;
+    raster_info.y1 = y;
+    raster_info.pending = true;
+}
+
+/**
+ * @brief   Integer square root
+ * @param   value   Value
+ * @return  Largest root with root * root <= value
+ */
+static uint32_t isqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+/**
+ * @brief   x of an edge at row y, rounded to the nearest pixel
+ * @param   a   Edge start
+ * @param   b   Edge end (a->y != b->y)
+ * @param   y   Row
+ * @return  x coordinate
+ */
+static int16_t edge_x(const raster_point_t *a, const raster_point_t *b, int16_t y)
+{
+    int32_t num = (int32_t)(y - a->y) * (b->x - a->x) * 2;
+    int32_t den = (int32_t)(b->y - a->y) * 2;
+
+    /* Round half away from zero */
+    if ((num < 0) != (den < 0))
+    {
+        num -= abs(den) / 2;
+    }
+    else
+    {
+        num += abs(den) / 2;
+    }
+
+    return a->x + (int16_t)(num / den);
+}
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Line from (x0, y0) to (x1, y1) (Bresenham)
+ * @param   block   Block output
+ * @param   x0      Starting point (x)
+ * @param   y0      Starting point (y)
+ * @param   x1      End Point (x)
+ * @param   y1      End Point (y)
+ * @param   color   Colour (16-bit)
+ */
+void raster_draw_line(raster_block_t block,
+                      int16_t x0, int16_t y0,
+                      int16_t x1, int16_t y1,
+                      uint16_t color)
+{
+    int16_t dx = abs(x1 - x0);
+    int16_t sx = x0<x1 ? 1 : -1;
+    int16_t dy = -abs(y1 - y0);
+    int16_t sy = y0<y1 ? 1 : -1;
+    int16_t err = dx+dy;
+    int16_t e2;
+
+    span_begin(block, color);
+
+    while(1)
+    {
+        plot(x0, y0);
+        e2 = 2 * err;
+        if (e2 >= dy)
+        {
+            if(x0 == x1)
+                break;
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx)
+        {
+            if (y0 == y1)
+                break;
+            err += dx;
+            y0 += sy;
+        }
+    }
+
+    span_flush();
+}
+
+/**
+ * @brief   Circle outline with center at (xc, yc) with radius r
+ *          Each quadrant is traced on its own so its pixels are contiguous
+ *          and form runs
+ * @param   block   Block output
+ * @param   xc      Center of circle (x)
+ * @param   yc      Center of circle (y)
+ * @param   r       Radius
+ * @param   color   Colour (16-bit)
+ */
+void raster_draw_circle(raster_block_t block,
+                        int16_t xc, int16_t yc,
+                        int16_t r,
+                        uint16_t color)
+{
+    /* Quadrant signs of x and y */
+    static const int8_t quadrant[4][2] =
+    {
+        {-1,  1},
+        { 1,  1},
+        { 1, -1},
+        {-1, -1}
+    };
+    int16_t x, y;
+    int16_t err, e2;
+    uint8_t q;
+
+    span_begin(block, color);
+
+    for (q = 0; q < 4; q++)
+    {
+        x = -r;
+        y = 0;
+        err = 2 - 2 * r;
+
+        do
+        {
+            plot(xc + quadrant[q][0] * x, yc + quadrant[q][1] * y);
+            e2 = err;
+            if (e2 <= y)
+            {
+                err += ++y * 2 + 1;
+                if (-x == y && e2 <= x)
+                    e2 = 0;
+            }
+            if (e2 > x)
+                err += ++x * 2 + 1;
+        } while (x <= 0);
+
+        span_flush();
+    }
+}
+
+/**
+ * @brief   Filled circle with center at (xc, yc) with radius r
+ * @param   block   Block output
+ * @param   xc      Center of circle (x)
+ * @param   yc      Center of circle (y)
+ * @param   r       Radius
+ * @param   color   Colour (16-bit)
+ */
+void raster_fill_circle(raster_block_t block,
+                        int16_t xc, int16_t yc,
+                        int16_t r,
+                        uint16_t color)
+{
+    int16_t dy;
+    int16_t half;
+    uint32_t r2;
+
+    if (r < 0)
+    {
+        return;
+    }
+
+    span_begin(block, color);
+
+    /* r^2 + r keeps the outermost pixel of each row close to the outline */
+    r2 = (uint32_t)r * r + r;
+
+    for (dy = -r; dy <= r; dy++)
+    {
+        half = (int16_t)isqrt(r2 - (uint32_t)(dy * dy));
+
+        span(xc - half, xc + half, yc + dy);
+    }
+
+    span_flush();
+}
+
+/**
+ * @brief   Filled polygon (even-odd rule)
+ *          Rows are sampled at pixel centres with the bottom row of every
+ *          edge excluded, then horizontal edges are added so flat tops and
+ *          bottoms are filled up to the outline
+ * @param   block   Block output
+ * @param   points  Vertices in drawing order (closed implicitly)
+ * @param   count   Number of vertices (3 - RASTER_MAX_VERTICES)
+ * @param   color   Colour (16-bit)
+ */
+void raster_fill_polygon(raster_block_t block,
+                         const raster_point_t *points,
+                         uint8_t count,
+                         uint16_t color)
+{
+    int16_t node[RASTER_MAX_VERTICES];
+    int16_t y_min;
+    int16_t y_max;
+    int16_t y;
+    int16_t x;
+    uint8_t nodes;
+    uint8_t i, j, k;
+
+    ASSERT(points != NULL);
+    ASSERT(count <= RASTER_MAX_VERTICES);
+
+    if ((count < 3) || (count > RASTER_MAX_VERTICES))
+    {
+        return;
+    }
+
+    span_begin(block, color);
+
+    y_min = points[0].y;
+    y_max = points[0].y;
+
+    for (i = 1; i < count; i++)
+    {
+        y_min = min(y_min, points[i].y);
+        y_max = max(y_max, points[i].y);
+    }
+
+    for (y = y_min; y <= y_max; y++)
+    {
+        /* Edge crossings of this row */
+        nodes = 0;
+        j = count - 1;
+
+        for (i = 0; i < count; i++)
+        {
+            if (((points[i].y <= y) && (points[j].y > y)) ||
+                ((points[j].y <= y) && (points[i].y > y)))
+            {
+                x = edge_x(&points[i], &points[j], y);
+
+                /* Insertion sort, at most RASTER_MAX_VERTICES crossings */
+                for (k = nodes; (k > 0) && (node[k - 1] > x); k--)
+                {
+                    node[k] = node[k - 1];
+                }
+                node[k] = x;
+                nodes++;
+            }
+
+            j = i;
+        }
+
+        for (k = 0; k + 1 < nodes; k += 2)
+        {
+            span(node[k], node[k + 1], y);
+        }
+    }
+
+    span_flush();
+
+    /* Horizontal edges */
+    j = count - 1;
+
+    for (i = 0; i < count; i++)
+    {
+        if (points[i].y == points[j].y)
+        {
+            block(min(points[i].x, points[j].x), points[i].y,
+                  max(points[i].x, points[j].x), points[i].y,
+                  color);
+        }
+
+        j = i;
+    }
+}
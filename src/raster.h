@@ -0,0 +1,82 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  raster.h
+ *
+ *    Description:  Scanline span and outline run rasteriser header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 04:41:09 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef RASTER_H
+#define RASTER_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+
+/*-----------------------------------------------------------------------------
+ *  Constants
+ *-----------------------------------------------------------------------------*/
+
+/* Maximum number of polygon vertices */
+#define RASTER_MAX_VERTICES     (16U)
+
+/*-----------------------------------------------------------------------------
+ *  Types
+ *-----------------------------------------------------------------------------*/
+
+/* Polygon vertex */
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+} raster_point_t;
+
+/*-----------------------------------------------------------------------------
+ *  Event call-backs
+ *-----------------------------------------------------------------------------*/
+
+/*
+ * Block output (x0, y0) to (x1, y1) inclusive, x0 <= x1 and y0 <= y1
+ * Coordinates may be off screen, the output clips
+ */
+typedef void (*raster_block_t)(int16_t x0, int16_t y0,
+                               int16_t x1, int16_t y1,
+                               uint16_t color);
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+void raster_draw_line(raster_block_t block,
+                      int16_t x0, int16_t y0,
+                      int16_t x1, int16_t y1,
+                      uint16_t color);
+void raster_draw_circle(raster_block_t block,
+                        int16_t xc, int16_t yc,
+                        int16_t r,
+                        uint16_t color);
+void raster_fill_circle(raster_block_t block,
+                        int16_t xc, int16_t yc,
+                        int16_t r,
+                        uint16_t color);
+void raster_fill_polygon(raster_block_t block,
+                         const raster_point_t *points,
+                         uint8_t count,
+                         uint16_t color);
+
+#endif
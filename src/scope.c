@@ -0,0 +1,364 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  scope.c
+ *
+ *    Description:  Oscilloscope trace widget implementation file
+ *                  A trace is one sample per column of a registered plot
+ *                  rectangle, joined by vertical segments. The rows of the
+ *                  previous trace are kept, so a new trace only erases the
+ *                  part of each old segment it does not cover and draws the
+ *                  part of each new segment that was not drawn: the pixels
+ *                  sent scale with the trace, not with the plot area.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 08:52:06 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "scope.h"
+#include "tft.h"
+#include "setting.h"
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+/* Segment of a column, top to bottom row (inclusive) */
+typedef struct
+{
+    uint16_t top;
+    uint16_t bottom;
+} segment_t;
+
+typedef struct
+{
+    /* Plot is registered */
+    bool     used;
+
+    /* Plot rectangle */
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+
+    /* Sample values at the bottom and top of the plot */
+    int16_t  min_value;
+    int16_t  max_value;
+
+    uint16_t fgcolor;
+    uint16_t bgcolor;
+
+    /* Rows of the previous trace (count columns drawn) */
+    uint16_t row[SCOPE_MAX_WIDTH];
+    uint16_t count;
+
+    /* Trace being drawn: next column and rows of the column before it */
+    uint16_t column;
+    uint16_t last_old;
+    uint16_t last_new;
+} scope_info_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static scope_info_t scope_info[SCOPE_COUNT];
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Registered plot of an ID
+ * @param   id  Plot ID
+ * @return  Plot, NULL if not registered
+ */
+static scope_info_t *get_scope(uint8_t id)
+{
+    if ((id >= SCOPE_COUNT) || !scope_info[id].used)
+    {
+        return NULL;
+    }
+
+    return &scope_info[id];
+}
+
+/**
+ * @brief   Screen row of a sample value, clamped to the plot
+ * @param   scope   Plot
+ * @param   value   Sample value
+ * @return  Row (y coordinate)
+ */
+static uint16_t sample_row(const scope_info_t *scope, int16_t value)
+{
+    int32_t span = (int32_t)scope->max_value - scope->min_value;
+    int32_t level;
+
+    value = constrain(value, scope->min_value, scope->max_value);
+
+    /* Rounded to the nearest row, max_value is the top row */
+    level = (((int32_t)value - scope->min_value) * (scope->height - 1) +
+             span / 2) / span;
+
+    return scope->y + scope->height - 1 - (uint16_t)level;
+}
+
+/**
+ * @brief   Segment joining the row of a column to the row before it
+ * @param   row0    Row of the column before
+ * @param   row1    Row of the column
+ * @return  Segment
+ */
+static segment_t segment(uint16_t row0, uint16_t row1)
+{
+    segment_t seg;
+
+    seg.top = min(row0, row1);
+    seg.bottom = max(row0, row1);
+
+    return seg;
+}
+
+/**
+ * @brief   Fill rows top to bottom of a column if not empty
+ * @param   x       Column
+ * @param   top     First row
+ * @param   bottom  Last row (empty if above top)
+ * @param   color   Colour (16-bit)
+ */
+static void fill_rows(uint16_t x, int32_t top, int32_t bottom, uint16_t color)
+{
+    if (top <= bottom)
+    {
+        tft_fill_area(x, top, x, bottom, color);
+    }
+}
+
+/**
+ * @brief   Replace the old segment of a column by the new one
+ *          Old rows not in the new segment are erased, new rows not in the
+ *          old segment are drawn
+ * @param   scope   Plot
+ * @param   x       Column
+ * @param   old     Old segment (NULL if none)
+ * @param   new     New segment (NULL if none)
+ */
+static void update_column(const scope_info_t *scope, uint16_t x,
+                          const segment_t *old, const segment_t *new)
+{
+    if (old == NULL)
+    {
+        fill_rows(x, new->top, new->bottom, scope->fgcolor);
+    }
+    else if (new == NULL)
+    {
+        fill_rows(x, old->top, old->bottom, scope->bgcolor);
+    }
+    else if ((new->bottom < old->top) || (new->top > old->bottom))
+    {
+        /* Disjoint */
+        fill_rows(x, old->top, old->bottom, scope->bgcolor);
+        fill_rows(x, new->top, new->bottom, scope->fgcolor);
+    }
+    else
+    {
+        fill_rows(x, old->top, (int32_t)new->top - 1, scope->bgcolor);
+        fill_rows(x, (int32_t)new->bottom + 1, old->bottom, scope->bgcolor);
+        fill_rows(x, new->top, (int32_t)old->top - 1, scope->fgcolor);
+        fill_rows(x, (int32_t)old->bottom + 1, new->bottom, scope->fgcolor);
+    }
+}
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Register a plot and clear its rectangle
+ * @param   id      Plot ID (0 - SCOPE_COUNT - 1)
+ * @param   region  Plot rectangle (width 1 - SCOPE_MAX_WIDTH columns), sample
+ *                  values at the bottom and top rows, trace and background
+ *                  colours
+ * @return  True if registered
+ */
+bool scope_register(uint8_t id, const chart_region_t *region)
+{
+    scope_info_t *scope;
+
+    ASSERT(region != NULL);
+
+    if ((id >= SCOPE_COUNT) ||
+        (region->width == 0) || (region->width > SCOPE_MAX_WIDTH) ||
+        (region->height == 0) ||
+        (region->min_value >= region->max_value) ||
+        ((uint32_t)region->x + region->width > tft_get_width()) ||
+        ((uint32_t)region->y + region->height > tft_get_height()))
+    {
+        return false;
+    }
+
+    scope = &scope_info[id];
+    scope->x = region->x;
+    scope->y = region->y;
+    scope->width = region->width;
+    scope->height = region->height;
+    scope->min_value = region->min_value;
+    scope->max_value = region->max_value;
+    scope->fgcolor = region->fgcolor;
+    scope->bgcolor = region->bgcolor;
+    scope->count = 0;
+    scope->column = 0;
+    scope->used = true;
+
+    tft_fill_area(scope->x, scope->y,
+                  scope->x + scope->width - 1, scope->y + scope->height - 1,
+                  scope->bgcolor);
+
+    return true;
+}
+
+/**
+ * @brief   Remove a plot (its rectangle is left as drawn)
+ * @param   id      Plot ID
+ */
+void scope_remove(uint8_t id)
+{
+    if (id < SCOPE_COUNT)
+    {
+        scope_info[id].used = false;
+    }
+}
+
+/**
+ * @brief   Start a new trace, samples follow from the left column
+ * @param   id      Plot ID
+ */
+void scope_trace_begin(uint8_t id)
+{
+    scope_info_t *scope = get_scope(id);
+
+    if (scope != NULL)
+    {
+        scope->column = 0;
+    }
+}
+
+/**
+ * @brief   Add the next sample of the trace and update its column
+ *          Samples beyond the plot width are ignored
+ * @param   id      Plot ID
+ * @param   value   Sample value
+ */
+void scope_trace_sample(uint8_t id, int16_t value)
+{
+    scope_info_t *scope = get_scope(id);
+    segment_t old, new;
+    uint16_t  row;
+    uint16_t  column;
+
+    if ((scope == NULL) || (scope->column >= scope->width))
+    {
+        return;
+    }
+
+    column = scope->column++;
+    row = sample_row(scope, value);
+
+    /* The first column has no segment before it */
+    new = segment((column > 0) ? scope->last_new : row, row);
+
+    if (column < scope->count)
+    {
+        old = segment((column > 0) ? scope->last_old : scope->row[column],
+                      scope->row[column]);
+
+        update_column(scope, scope->x + column, &old, &new);
+
+        scope->last_old = scope->row[column];
+    }
+    else
+    {
+        update_column(scope, scope->x + column, NULL, &new);
+    }
+
+    scope->row[column] = row;
+    scope->last_new = row;
+}
+
+/**
+ * @brief   End the trace: columns of the previous trace beyond it are erased
+ * @param   id      Plot ID
+ */
+void scope_trace_end(uint8_t id)
+{
+    scope_info_t *scope = get_scope(id);
+    segment_t old;
+    uint16_t  column;
+
+    if (scope == NULL)
+    {
+        return;
+    }
+
+    for (column = scope->column; column < scope->count; column++)
+    {
+        old = segment((column > 0) ? scope->last_old : scope->row[column],
+                      scope->row[column]);
+
+        update_column(scope, scope->x + column, &old, NULL);
+
+        scope->last_old = scope->row[column];
+    }
+
+    scope->count = scope->column;
+}
+
+/**
+ * @brief   Draw a whole trace
+ * @param   id      Plot ID
+ * @param   samples Sample values, one per column
+ * @param   count   Number of samples
+ */
+void scope_draw_trace(uint8_t id, const int16_t *samples, uint16_t count)
+{
+    uint16_t i;
+
+    ASSERT(samples != NULL);
+
+    scope_trace_begin(id);
+
+    for (i = 0; i < count; i++)
+    {
+        scope_trace_sample(id, samples[i]);
+    }
+
+    scope_trace_end(id);
+}
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Scope initialisation
+ */
+void scope_init(void)
+{
+    uint8_t id;
+
+    for (id = 0; id < SCOPE_COUNT; id++)
+    {
+        scope_info[id].used = false;
+    }
+}
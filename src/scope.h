@@ -0,0 +1,49 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  scope.h
+ *
+ *    Description:  Oscilloscope trace widget header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 08:52:06 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef SCOPE_H
+#define SCOPE_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+#include "chart.h"
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+bool scope_register(uint8_t id, const chart_region_t *region);
+void scope_remove(uint8_t id);
+void scope_trace_begin(uint8_t id);
+void scope_trace_sample(uint8_t id, int16_t value);
+void scope_trace_end(uint8_t id);
+void scope_draw_trace(uint8_t id, const int16_t *samples, uint16_t count);
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+void scope_init(void);
+
+#endif
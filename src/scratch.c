@@ -0,0 +1,88 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  scratch.c
+ *
+ *    Description:  Shared scratch memory implementation file
+ *                  The band strips, the glyph cache pool and the JPEG
+ *                  decoder state are never needed at the same time, so
+ *                  they share one block of SRAM. A user claims the block
+ *                  before touching it; whatever the previous holder left
+ *                  there is lost, so the glyph cache starts empty again
+ *                  after a band frame or a JPEG image.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 11:02:33 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "scratch.h"
+#include "spi.h"
+#include "setting.h"
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+/* Word aligned for the JPEG coefficients */
+static uint32_t         scratch[SCRATCH_SIZE / sizeof(uint32_t)];
+
+static scratch_owner_t  scratch_holder;
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Claim the scratch memory
+ *          If another user held it, its last uDMA transfer (which may still
+ *          be reading the memory) is waited for and its content is lost
+ * @param   owner   New holder
+ * @param   size    Bytes needed
+ * @return  Scratch memory
+ */
+void *scratch_claim(scratch_owner_t owner, uint32_t size)
+{
+    ASSERT(owner != SCRATCH_FREE);
+    ASSERT(size <= SCRATCH_SIZE);
+
+    if (owner != scratch_holder)
+    {
+        spi_flush(SPI_TFT);
+
+        scratch_holder = owner;
+    }
+
+    return &scratch[0];
+}
+
+/**
+ * @brief   Current holder of the scratch memory
+ * @return  Holder (SCRATCH_FREE if never claimed)
+ */
+scratch_owner_t scratch_owner(void)
+{
+    return scratch_holder;
+}
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Scratch memory initialisation
+ */
+void scratch_init(void)
+{
+    scratch_holder = SCRATCH_FREE;
+}
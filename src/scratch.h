@@ -0,0 +1,57 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  scratch.h
+ *
+ *    Description:  Shared scratch memory header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 11:02:33 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef SCRATCH_H
+#define SCRATCH_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+
+/*-----------------------------------------------------------------------------
+ *  Types
+ *-----------------------------------------------------------------------------*/
+
+/* Holder of the scratch memory */
+typedef enum
+{
+    SCRATCH_FREE = 0,
+    SCRATCH_BAND,
+    SCRATCH_GLYPH_CACHE,
+    SCRATCH_JPEG
+} scratch_owner_t;
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+void *scratch_claim(scratch_owner_t owner, uint32_t size);
+scratch_owner_t scratch_owner(void);
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+void scratch_init(void);
+
+#endif
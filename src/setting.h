@@ -48,6 +48,101 @@
 /* SSI Speed Definition */
 #define SSI_SPEED               (25000000U)
 
+/* Band renderer */
+/* Pixels of strip buffer, split in two ping-pong strips (240x16 = 7.5 KB) */
+#define BAND_BUFFER_PIXELS      (240U * 16U)
+
+/* Scratch memory (bytes) - band strips, glyph cache pool or JPEG decoder
+ * state, one at a time */
+#define SCRATCH_SIZE            (BAND_BUFFER_PIXELS * 2U)
+
+/* Display list size (bytes) - a frame larger than this is drawn immediately */
+#define DLIST_SIZE              (2048U)
+
+/* Glyph cache */
+/* Pool of pre-expanded glyphs (bytes) - one size 6 glyph takes 784 bytes,
+ * held in the scratch memory and emptied when a band frame or a JPEG image
+ * takes it */
+#define GLYPH_CACHE_SIZE        (4096U)
+
+/* Maximum number of cached glyphs */
+#define GLYPH_CACHE_ENTRIES     (16U)
+
+/* Largest font size cached, larger glyphs are expanded line by line */
+#define GLYPH_CACHE_MAX_SIZE    (6U)
+
+/* Strip charts */
+/* Number of charts registered at a time */
+#define CHART_COUNT             (4U)
+
+/* Oscilloscope plots */
+/* Number of plots registered at a time */
+#define SCOPE_COUNT             (2U)
+
+/* Widest plot (columns) - each plot keeps 2 bytes per column */
+#define SCOPE_MAX_WIDTH         (320U)
+
+/* Numeric fields */
+/* Number of fields registered at a time */
+#define NUMFIELD_COUNT          (8U)
+
+/* Widest field (character cells) - "-2147483648" needs 11 */
+#define NUMFIELD_MAX_WIDTH      (11U)
+
+/* JPEG decoder */
+/* Input buffer - every header segment and MCU must fit */
+#define JPEG_INPUT_SIZE         (1024U)
+
+/* Tile map */
+/* Tile set memory (bytes) - an 8x8 tile takes 128 (RGB565) or 32 (4-bpp),
+ * so 16 RGB565 or 64 indexed tiles */
+#define TILESET_SIZE            (2048U)
+
+/* Largest map (cells, one byte each) - 40 x 30 covers the screen with 8x8
+ * tiles */
+#define TILEMAP_CELLS           (1200U)
+
+/* Sprites */
+/* Number of sprites */
+#define SPRITE_COUNT            (16U)
+
+/* Atlas memory (bytes) - a 16x16 sprite takes 512 (RGB565) or 128 (4-bpp),
+ * so 4 RGB565 or 16 indexed 16x16 images */
+#define SPRITE_ATLAS_SIZE       (2048U)
+
+/* Widest sprite and widest repaint (pixels) - two lines are buffered, a
+ * wider old and new box pair is repainted box by box */
+#define SPRITE_LINE_SIZE        (64U)
+
+
+/*-----------------------------------------------------------------------------
+ *  RAM budget
+ *-----------------------------------------------------------------------------*/
+
+/* Bytes of the 32 KB SRAM, from the link map (.bss and .data per module)
+ *
+ *   uDMA control table (dma_hal.c, 1 KB aligned, first in SRAM)    1024
+ *   Stack (pulStack in LM4F_startup.c)                             2048
+ *   UART (UART_RX_BUFFER_SIZE + UART_TX_BUFFER_SIZE, state)        4740
+ *   Scratch memory (SCRATCH_SIZE)                                  7684
+ *   Display list (DLIST_SIZE)                                      2056
+ *   Command parser (data[], image lines, palette, text)            3475
+ *   TFT (glyph lines, glyph cache index)                           1568
+ *   Tile map (TILESET_SIZE + TILEMAP_CELLS + chunks)               3560
+ *   Sprites (SPRITE_ATLAS_SIZE + lines + SPRITE_COUNT sprites)     2628
+ *   Oscilloscope plots (SCOPE_COUNT x SCOPE_MAX_WIDTH x 2)         1332
+ *   Event list, fields, charts, QOI, fonts, SPI, band, ...         1003
+ *   Alignment padding                                               302
+ *   .data                                                             4
+ *                                                                 -----
+ *   Total                                                         31424
+ *   Free                                                           1344
+ *
+ * The stack holds the deepest command call chain measured with -fstack-usage
+ * (about 1.1 KB, a numeric field or sprite command down to the SSI drain),
+ * one interrupt (256 bytes) and the exception frames. The link fails if
+ * .bss and .data outgrow SRAM, so a buffer added here comes out of Free.
+ */
 
 #endif
 
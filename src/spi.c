@@ -21,10 +21,12 @@
  *-----------------------------------------------------------------------------*/
 /* Local Includes */
 #include "spi.h"
+#include "dma.h"
 #include "ringbuf.h"
 #include "setting.h"
 
 /* Third party libraries include */
+#include "inc/hw_ssi.h"
 #include "driverlib/ssi.h"
 
 /* Local includes */
@@ -49,14 +51,21 @@ typedef enum
 typedef struct
 {
     /* Internal State of SSI */
-    spi_state_t state;
+    /* Shared between ISR and non-ISR context. */
+    volatile spi_state_t state;
 
     /* Store SSI Instance */
     spi_instance_t instance;
 
+    /* Current data frame width (8 or 16 bits) */
+    uint8_t data_width;
+
     /* Client data available callback */
     spi_tx_cb_t tx_cb;
 
+    /* Transmit complete event handle */
+    evl_cb_handle_t evl_tx_handle;
+
 } spi_info_t;
 
 /*-----------------------------------------------------------------------------
@@ -97,6 +106,13 @@ static const uint32_t ssi_int[] =
     INT_SSI1,
 };
 
+/* SSI TX uDMA channel map (NULL if TX is CPU driven only) */
+static const dma_hal_t * const ssi_dma_hal[] =
+{
+    &dma_hal_ssi0_tx,
+    NULL
+};
+
 /* SSI GPIO Port Map */
 static const uint32_t ssi_gpio_port[] = 
 {
@@ -116,10 +132,47 @@ static const uint32_t ssi_gpio_pin[] =
 /* Per-SPI info */
 static spi_info_t spi_info[SPI_COUNT];
 
+/* Event loop services */
+static evl_services_t *evl;
+
 /*-----------------------------------------------------------------------------
  *  Helper Functions
  *-----------------------------------------------------------------------------*/
 
+/**
+ * @brief   Discard all dummy frames in RX FIFO without blocking
+ * @param   base    SSI base address
+ */
+static void drain_rx(uint32_t base)
+{
+    unsigned long rx_data;
+
+    while(ROM_SSIDataGetNonBlocking(base, &rx_data));
+}
+
+/**
+ * @brief   Put one frame into TX FIFO, draining RX FIFO while TX FIFO is full
+ * @param   base    SSI base address
+ * @param   frame   Frame to be transmitted
+ */
+static void put_frame(uint32_t base, uint32_t frame)
+{
+    while(ROM_SSIDataPutNonBlocking(base, frame) == 0)
+    {
+        drain_rx(base);
+    }
+}
+
+/**
+ * @brief   Wait until the last frame is shifted out and flush RX FIFO
+ * @param   base    SSI base address
+ */
+static void wait_idle(uint32_t base)
+{
+    while(SSIBusy(base));
+
+    drain_rx(base);
+}
 
 /*-----------------------------------------------------------------------------
  *  Event call-backs
@@ -221,6 +274,25 @@ static void spi_irq(spi_instance_t spi_instance)
 }
 #endif
 
+/**
+ * SPI uDMA transfer IRQ Handler
+ * uDMA completion is signalled on the SSI interrupt vector
+ * @param spi_instance  SPI instance
+ */
+static void spi_dma_irq(spi_instance_t spi_instance)
+{
+    spi_info_t *info = &spi_info[spi_instance];
+
+    /* Reload the next chunk or finish the transfer */
+    if (dma_service())
+    {
+        info->state = SPI_READY;
+
+        /* Schedule transmit complete callback */
+        evl->schedule(info->evl_tx_handle);
+    }
+}
+
 /**
  * SSI0 Interrupt Handler
  */
@@ -229,6 +301,7 @@ void SSI0IntHandler(void)
 #if USE_INTERRUPT
     spi_irq(SPI_TFT);
 #endif
+    spi_dma_irq(SPI_TFT);
 }
 
 /*-----------------------------------------------------------------------------
@@ -258,6 +331,9 @@ void spi_open(spi_instance_t spi_instance,
     /* Subscribe data available callback */
     info->tx_cb = spi_tx_cb;
 
+    /* Allocate transmit complete event */
+    info->evl_tx_handle = evl->cb_alloc(spi_tx_evl_cb, spi_instance);
+
     /* Initialise SSI peripheral */
     ROM_SysCtlPeripheralEnable(ssi_peripheral[spi_instance]);
 
@@ -292,7 +368,9 @@ void spi_open(spi_instance_t spi_instance,
                            SSI_FRF_MOTO_MODE_0,
                            SSI_MODE_MASTER, 
                            SSI_SPEED,
-                           8);
+                           SPI_DATA_WIDTH_8);
+
+    info->data_width = SPI_DATA_WIDTH_8;
 
 #if USE_INTERRUPT
     /* Enable Interrupt for SSI */
@@ -300,6 +378,16 @@ void spi_open(spi_instance_t spi_instance,
 
     ROM_IntEnable(ssi_int[spi_instance]);
 #endif
+
+    /* Attach TX uDMA channel, completion raises the SSI interrupt */
+    if (ssi_dma_hal[spi_instance] != NULL)
+    {
+        dma_open(ssi_dma_hal[spi_instance]);
+
+        ROM_SSIDMAEnable(base, SSI_DMA_TX);
+
+        ROM_IntEnable(ssi_int[spi_instance]);
+    }
     
     /* Clear any residual data */
     unsigned long dummy_read_buffer[8];
@@ -347,6 +435,216 @@ void spi_write(spi_instance_t spi_instance,
     ROM_SSIDataGet(base, &rx_data);
 }
 
+/**
+ * @brief   Write one 16-bit frame to SPI (Blocking)
+ *          SSI must be in 16-bit frame mode, MSB is shifted out first so the
+ *          bus sees the same byte order as two 8-bit writes
+ * @param   spi_instance  SPI instance
+ * @param   data          Write data word
+ */
+void spi_write_word(spi_instance_t spi_instance,
+                    uint16_t       data)
+{
+    ASSERT(spi_instance < SPI_COUNT);
+    ASSERT(spi_info[spi_instance].data_width == SPI_DATA_WIDTH_16);
+
+    uint32_t base = ssi_base[spi_instance];
+
+    /* Wait until SPI is ready */
+    while(SSIBusy(base));
+    while(spi_info[spi_instance].state != SPI_READY);
+
+    /* Write Data to SSI */
+    ROM_SSIDataPut(base, data);
+
+    /* Get dummy data from SSI */
+    unsigned long rx_data;
+    ROM_SSIDataGet(base, &rx_data);
+}
+
+/**
+ * @brief   Write a block of data to SPI keeping TX FIFO full (Blocking)
+ *          In 16-bit frame mode, bytes are packed in pairs, MSB first
+ *          Only returns once the last frame has been shifted out
+ * @param   spi_instance  SPI instance
+ * @param   data          Write data
+ * @param   size          Write data size (bytes)
+ */
+void spi_write_burst(spi_instance_t spi_instance,
+                     const uint8_t  *data,
+                     uint32_t       size)
+{
+    ASSERT(spi_instance < SPI_COUNT);
+    ASSERT(data != NULL);
+
+    uint32_t base = ssi_base[spi_instance];
+    uint32_t i;
+
+    while(spi_info[spi_instance].state != SPI_READY);
+
+    if (spi_info[spi_instance].data_width == SPI_DATA_WIDTH_16)
+    {
+        ASSERT((size % 2) == 0);
+
+        for (i = 0; (i + 1) < size; i += 2)
+        {
+            put_frame(base, convert_to_word(data[i], data[i + 1]));
+        }
+    }
+    else
+    {
+        for (i = 0; i < size; i++)
+        {
+            put_frame(base, data[i]);
+        }
+    }
+
+    wait_idle(base);
+}
+
+/**
+ * @brief   Write 16-bit frames keeping TX FIFO full (Blocking)
+ *          Only returns once the last frame has been shifted out
+ * @param   spi_instance  SPI instance
+ * @param   data          Frames
+ * @param   count         Number of frames
+ */
+void spi_write_words(spi_instance_t spi_instance,
+                     const uint16_t *data,
+                     uint32_t       count)
+{
+    ASSERT(spi_instance < SPI_COUNT);
+    ASSERT(data != NULL);
+    ASSERT(spi_info[spi_instance].data_width == SPI_DATA_WIDTH_16);
+
+    uint32_t base = ssi_base[spi_instance];
+
+    while(spi_info[spi_instance].state != SPI_READY);
+
+    while (count > 0)
+    {
+        put_frame(base, *data++);
+        count--;
+    }
+
+    wait_idle(base);
+}
+
+/**
+ * @brief   Write the same frame count times keeping TX FIFO full (Blocking)
+ *          Only returns once the last frame has been shifted out
+ * @param   spi_instance  SPI instance
+ * @param   pattern       Frame to be repeated (8 or 16 bits, as configured)
+ * @param   count         Number of frames
+ */
+void spi_write_repeat(spi_instance_t spi_instance,
+                      uint16_t       pattern,
+                      uint32_t       count)
+{
+    ASSERT(spi_instance < SPI_COUNT);
+
+    uint32_t base = ssi_base[spi_instance];
+
+    while(spi_info[spi_instance].state != SPI_READY);
+
+    while (count > 0)
+    {
+        put_frame(base, pattern);
+        count--;
+    }
+
+    wait_idle(base);
+}
+
+/**
+ * @brief   Write frames to SPI through uDMA (Non-Blocking)
+ *          Transmit complete callback is scheduled on the event loop once the
+ *          last frame is in the TX FIFO
+ * @param   spi_instance   SPI instance
+ * @param   src            Frames (uint8_t in 8-bit, uint16_t in 16-bit mode),
+ *                         must stay valid until the transfer completes
+ * @param   count          Number of frames
+ * @param   src_increment  False to send the frame at src count times
+ */
+void spi_write_dma(spi_instance_t spi_instance,
+                   const void     *src,
+                   uint32_t       count,
+                   bool           src_increment)
+{
+    ASSERT(spi_instance < SPI_COUNT);
+    ASSERT(ssi_dma_hal[spi_instance] != NULL);
+    ASSERT(count > 0);
+
+    spi_info_t *info = &spi_info[spi_instance];
+
+    /* Only one transfer at a time */
+    while(info->state != SPI_READY);
+
+    info->state = SPI_BUSY;
+
+    dma_start(src, count, info->data_width / 8, src_increment);
+}
+
+/**
+ * @brief   Wait until all pending frames are shifted out (Blocking)
+ * @param   spi_instance  SPI instance
+ */
+void spi_flush(spi_instance_t spi_instance)
+{
+    ASSERT(spi_instance < SPI_COUNT);
+
+    while(spi_info[spi_instance].state != SPI_READY);
+
+    wait_idle(ssi_base[spi_instance]);
+}
+
+/**
+ * @brief   Check whether a uDMA transfer is in progress
+ * @param   spi_instance  SPI instance
+ * @return  True if busy
+ */
+bool spi_busy(spi_instance_t spi_instance)
+{
+    ASSERT(spi_instance < SPI_COUNT);
+
+    return (spi_info[spi_instance].state != SPI_READY);
+}
+
+/**
+ * @brief   Change SSI data frame width
+ *          Only the DSS field of SSICR0 is updated, so clock rate and frame
+ *          format set in spi_open are kept
+ * @param   spi_instance  SPI instance
+ * @param   data_width    SPI_DATA_WIDTH_8 or SPI_DATA_WIDTH_16
+ */
+void spi_set_data_width(spi_instance_t spi_instance,
+                        uint8_t        data_width)
+{
+    ASSERT(spi_instance < SPI_COUNT);
+    ASSERT((data_width == SPI_DATA_WIDTH_8) ||
+           (data_width == SPI_DATA_WIDTH_16));
+
+    spi_info_t *info = &spi_info[spi_instance];
+    uint32_t base = ssi_base[spi_instance];
+
+    while(info->state != SPI_READY);
+
+    if (info->data_width != data_width)
+    {
+        /* Frame size must not change while a frame is being shifted out */
+        while(SSIBusy(base));
+
+        ROM_SSIDisable(base);
+
+        HWREG(base + SSI_O_CR0) = ((HWREG(base + SSI_O_CR0) & ~SSI_CR0_DSS_M) |
+                                   (data_width - 1));
+
+        ROM_SSIEnable(base);
+
+        info->data_width = data_width;
+    }
+}
+
 
 #if USE_INTERRUPT
 /**
@@ -385,15 +683,22 @@ void spi_write_non_blocking(spi_instance_t spi_instance,
 
 /**
  * @brief   SPI services initialisation
+ * @param   evl_services    Event loop services
  */
-void spi_init(void)
+void spi_init(evl_services_t *evl_services)
 {
+    ASSERT(evl_services != NULL);
 
     uint8_t i;
+
+    evl = evl_services;
+
+    dma_init();
     
     /* SPI internal info initialisation */
     for (i = 0; i < SPI_COUNT; i++)
     {
         spi_info[i].state = SPI_READY;
+        spi_info[i].data_width = SPI_DATA_WIDTH_8;
     }
 }
@@ -27,6 +27,7 @@
 
 /* Local includes */
 #include "lib.h"
+#include "evl.h"
 
 /*-----------------------------------------------------------------------------
  *  Constants
@@ -34,6 +35,10 @@
 
 #define USE_INTERRUPT   0
 
+/* SSI data frame width */
+#define SPI_DATA_WIDTH_8    (8U)
+#define SPI_DATA_WIDTH_16   (16U)
+
 /*-----------------------------------------------------------------------------
  *  Types
  *-----------------------------------------------------------------------------*/
@@ -65,10 +70,37 @@ void spi_close(spi_instance_t spi_instance);
 
 void spi_write(spi_instance_t spi_instance,
                       uint8_t        data);
+
+void spi_write_word(spi_instance_t spi_instance,
+                    uint16_t       data);
+
+void spi_write_burst(spi_instance_t spi_instance,
+                     const uint8_t  *data,
+                     uint32_t       size);
+
+void spi_write_words(spi_instance_t spi_instance,
+                     const uint16_t *data,
+                     uint32_t       count);
+
+void spi_write_repeat(spi_instance_t spi_instance,
+                      uint16_t       pattern,
+                      uint32_t       count);
+
+void spi_write_dma(spi_instance_t spi_instance,
+                   const void     *src,
+                   uint32_t       count,
+                   bool           src_increment);
+
+void spi_flush(spi_instance_t spi_instance);
+
+bool spi_busy(spi_instance_t spi_instance);
+
+void spi_set_data_width(spi_instance_t spi_instance,
+                        uint8_t        data_width);
 /*-----------------------------------------------------------------------------
  *  Initialisation
  *-----------------------------------------------------------------------------*/
 
-void spi_init(void);
+void spi_init(evl_services_t *evl_services);
 
 #endif
@@ -0,0 +1,479 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  sprite.c
+ *
+ *    Description:  Sprite implementation file
+ *                  Sprite images are sub-rectangles of an atlas the host
+ *                  uploads once into RAM: RGB565 (MSB first, SPRITE_KEY is
+ *                  transparent) or 4-bpp indexed (high nibble first, rows
+ *                  byte aligned, index 0 is transparent) with a 16 colour
+ *                  palette.
+ *
+ *                  Every sprite has a position, a z-order and a background
+ *                  (a colour, or the tile map with the colour outside it).
+ *                  A change repaints only the union of the old and new
+ *                  bounding boxes (or both boxes when the union does not
+ *                  fit the line buffer): each line is composited from the
+ *                  background and every sprite, lowest z first, and sent
+ *                  while the next line is composited.
+ *
+ *                  Sprites are not redrawn when other commands draw over
+ *                  them.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 11:57:40 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "sprite.h"
+#include "tilemap.h"
+#include "tft.h"
+#include "setting.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* Transparent colour of RGB565 atlases (magenta) */
+#define SPRITE_KEY              (0xF81FU)
+
+/* Palette of indexed atlases */
+#define SPRITE_PALETTE_SIZE     (16U)
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+/* Screen rectangle (x1, y1 inclusive) */
+typedef struct
+{
+    uint16_t x0;
+    uint16_t y0;
+    uint16_t x1;
+    uint16_t y1;
+} sprite_rect_t;
+
+typedef struct
+{
+    /* Sprite is drawn (sprites are hidden until set) */
+    bool     visible;
+
+    /* Image: top left corner in the atlas and size */
+    uint16_t sx;
+    uint16_t sy;
+    uint8_t  width;
+    uint8_t  height;
+
+    /* Screen position of the top left corner */
+    uint16_t x;
+    uint16_t y;
+
+    /* Higher z is drawn over lower z */
+    uint8_t  z;
+
+    /* Background: the tile map, or bgcolor */
+    bool     tile_bg;
+    uint16_t bgcolor;
+} sprite_t;
+
+typedef struct
+{
+    /* Atlas size (0 until an atlas is loaded) and row length (bytes) */
+    uint16_t width;
+    uint16_t height;
+    uint8_t  bpp;
+    uint16_t stride;
+
+    uint16_t palette[SPRITE_PALETTE_SIZE];
+
+    /* Upload position: palette bytes still expected, next atlas byte */
+    uint8_t  palette_left;
+    uint32_t offset;
+
+    /* Sprite IDs, lowest z first */
+    uint8_t  order[SPRITE_COUNT];
+
+    uint8_t  line_index;
+} sprite_info_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static sprite_info_t sprite_info;
+
+static sprite_t sprites[SPRITE_COUNT];
+
+/* Atlas, stored as received */
+static uint8_t atlas[SPRITE_ATLAS_SIZE];
+
+/* Composited lines, one is filled while uDMA may still send the other */
+static uint16_t line[2][SPRITE_LINE_SIZE];
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Colour of an atlas pixel
+ * @param   x       Atlas x coordinate
+ * @param   y       Atlas y coordinate
+ * @param   color   Output: colour (16-bit)
+ * @return  False if the pixel is transparent or outside the atlas
+ */
+static bool atlas_pixel(uint16_t x, uint16_t y, uint16_t *color)
+{
+    sprite_info_t *info = &sprite_info;
+    const uint8_t *p;
+    uint8_t index;
+
+    if ((x >= info->width) || (y >= info->height))
+    {
+        return false;
+    }
+
+    p = &atlas[(uint32_t)y * info->stride + (uint32_t)x * info->bpp / 8];
+
+    if (info->bpp == 16)
+    {
+        *color = convert_to_word(p[0], p[1]);
+
+        return (*color != SPRITE_KEY);
+    }
+
+    index = (x & 1) ? (p[0] & 0x0f) : (p[0] >> 4);
+    *color = info->palette[index];
+
+    return (index != 0);
+}
+
+/**
+ * @brief   Screen rectangle covered by a sprite, clipped to the screen
+ * @param   sprite  Sprite
+ * @param   rect    Output: rectangle
+ * @return  False if the sprite is hidden or off the screen
+ */
+static bool sprite_bounds(const sprite_t *sprite, sprite_rect_t *rect)
+{
+    if (!sprite->visible ||
+        (sprite->x >= tft_get_width()) || (sprite->y >= tft_get_height()))
+    {
+        return false;
+    }
+
+    rect->x0 = sprite->x;
+    rect->y0 = sprite->y;
+    rect->x1 = min((uint32_t)sprite->x + sprite->width - 1,
+                   (uint32_t)tft_get_width() - 1);
+    rect->y1 = min((uint32_t)sprite->y + sprite->height - 1,
+                   (uint32_t)tft_get_height() - 1);
+
+    return true;
+}
+
+/**
+ * @brief   Sort the sprite IDs by z (insertion sort, equal z keep ID order)
+ */
+static void sort_order(void)
+{
+    uint8_t *order = &sprite_info.order[0];
+    uint8_t i, j;
+    uint8_t id;
+
+    for (i = 1; i < SPRITE_COUNT; i++)
+    {
+        id = order[i];
+
+        for (j = i; (j > 0) && (sprites[order[j - 1]].z > sprites[id].z); j--)
+        {
+            order[j] = order[j - 1];
+        }
+
+        order[j] = id;
+    }
+}
+
+/**
+ * @brief   Composite and draw a rectangle in one window
+ * @param   owner   Sprite whose background fills the rectangle
+ * @param   rect    Rectangle (at most SPRITE_LINE_SIZE wide)
+ */
+static void repaint(const sprite_t *owner, const sprite_rect_t *rect)
+{
+    const sprite_t *sprite;
+    uint16_t width = rect->x1 - rect->x0 + 1;
+    uint16_t *out;
+    uint16_t color;
+    uint32_t x, x0, x1;
+    uint16_t y;
+    uint8_t  i;
+
+    ASSERT(width <= SPRITE_LINE_SIZE);
+
+    tft_start_image_transfer(rect->x0, rect->y0, rect->x1, rect->y1);
+
+    for (y = rect->y0; y <= rect->y1; y++)
+    {
+        out = &line[sprite_info.line_index][0];
+        sprite_info.line_index ^= 1;
+
+        /* Background */
+        if (owner->tile_bg)
+        {
+            tilemap_read(rect->x0, y, width, owner->bgcolor, out);
+        }
+        else
+        {
+            for (x = 0; x < width; x++)
+            {
+                out[x] = owner->bgcolor;
+            }
+        }
+
+        /* Sprites crossing the line, lowest z first */
+        for (i = 0; i < SPRITE_COUNT; i++)
+        {
+            sprite = &sprites[sprite_info.order[i]];
+
+            if (!sprite->visible || (y < sprite->y) ||
+                (y - sprite->y >= sprite->height))
+            {
+                continue;
+            }
+
+            x0 = max(rect->x0, sprite->x);
+            x1 = min(rect->x1, (uint32_t)sprite->x + sprite->width - 1);
+
+            for (x = x0; x <= x1; x++)
+            {
+                if (atlas_pixel(sprite->sx + (x - sprite->x),
+                                sprite->sy + (y - sprite->y), &color))
+                {
+                    out[x - rect->x0] = color;
+                }
+            }
+        }
+
+        tft_send_pixels(out, width);
+    }
+
+    tft_done_transfer();
+}
+
+/**
+ * @brief   Repaint a sprite after a change
+ *          One repaint of the union of the old and new boxes if they
+ *          overlap and the union fits the line buffer, else each box
+ * @param   id      Sprite ID
+ * @param   old     Box before the change
+ * @param   had_old False if the sprite was not on the screen
+ */
+static void redraw(uint8_t id, const sprite_rect_t *old, bool had_old)
+{
+    const sprite_t *sprite = &sprites[id];
+    sprite_rect_t now;
+    sprite_rect_t both;
+    bool has_now = sprite_bounds(sprite, &now);
+
+    if (had_old && has_now &&
+        (old->x0 <= now.x1) && (now.x0 <= old->x1) &&
+        (old->y0 <= now.y1) && (now.y0 <= old->y1))
+    {
+        both.x0 = min(old->x0, now.x0);
+        both.y0 = min(old->y0, now.y0);
+        both.x1 = max(old->x1, now.x1);
+        both.y1 = max(old->y1, now.y1);
+
+        if (both.x1 - both.x0 < SPRITE_LINE_SIZE)
+        {
+            repaint(sprite, &both);
+            return;
+        }
+    }
+
+    if (had_old)
+    {
+        repaint(sprite, old);
+    }
+
+    if (has_now)
+    {
+        repaint(sprite, &now);
+    }
+}
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Start loading the atlas
+ *          An indexed atlas is preceded by its 16 colour palette (MSB first)
+ * @param   width   Atlas width
+ * @param   height  Atlas height
+ * @param   bpp     Bits per pixel (16 for RGB565 or 4 for indexed)
+ * @return  False if the format is not supported or the atlas does not
+ *          fit SPRITE_ATLAS_SIZE
+ */
+bool sprite_load_begin(uint16_t width, uint16_t height, uint8_t bpp)
+{
+    sprite_info_t *info = &sprite_info;
+    uint16_t stride;
+
+    if ((bpp != 16) && (bpp != 4))
+    {
+        return false;
+    }
+
+    stride = (bpp == 16) ? (2 * width) : ((width + 1) / 2);
+
+    if ((uint32_t)stride * height > SPRITE_ATLAS_SIZE)
+    {
+        return false;
+    }
+
+    info->width = width;
+    info->height = height;
+    info->bpp = bpp;
+    info->stride = stride;
+    info->palette_left = (bpp == 4) ? (2 * SPRITE_PALETTE_SIZE) : 0;
+    info->offset = 0;
+
+    return true;
+}
+
+/**
+ * @brief   Load the next byte of the palette or of the atlas
+ * @param   byte    Received byte
+ */
+void sprite_load(uint8_t byte)
+{
+    sprite_info_t *info = &sprite_info;
+    uint8_t index;
+
+    if (info->palette_left > 0)
+    {
+        index = SPRITE_PALETTE_SIZE - (info->palette_left + 1) / 2;
+
+        if (info->palette_left & 1)
+        {
+            info->palette[index] |= byte;
+        }
+        else
+        {
+            info->palette[index] = (uint16_t)byte << 8;
+        }
+
+        info->palette_left--;
+    }
+    else if (info->offset < (uint32_t)info->stride * info->height)
+    {
+        atlas[info->offset++] = byte;
+    }
+}
+
+/**
+ * @brief   Set up a sprite and repaint where it was and where it is
+ * @param   id      Sprite ID (0 - SPRITE_COUNT - 1)
+ * @param   params  Image (width 1 - SPRITE_LINE_SIZE), position, z-order,
+ *                  background and visibility
+ * @return  False if the sprite is not valid
+ */
+bool sprite_set(uint8_t id, const sprite_params_t *params)
+{
+    sprite_t *sprite;
+    sprite_rect_t old;
+    bool had_old;
+
+    ASSERT(params != NULL);
+
+    if ((id >= SPRITE_COUNT) || (params->width == 0) ||
+        (params->width > SPRITE_LINE_SIZE) || (params->height == 0))
+    {
+        return false;
+    }
+
+    sprite = &sprites[id];
+    had_old = sprite_bounds(sprite, &old);
+
+    sprite->sx = params->sx;
+    sprite->sy = params->sy;
+    sprite->width = params->width;
+    sprite->height = params->height;
+    sprite->x = params->x;
+    sprite->y = params->y;
+    sprite->z = params->z;
+    sprite->bgcolor = params->bgcolor;
+    sprite->tile_bg = params->tile_bg;
+    sprite->visible = params->visible;
+
+    sort_order();
+
+    redraw(id, &old, had_old);
+
+    return true;
+}
+
+/**
+ * @brief   Move a sprite
+ *          Only the old and new boxes are repainted
+ * @param   id  Sprite ID
+ * @param   x   Screen x coordinate
+ * @param   y   Screen y coordinate
+ */
+void sprite_move(uint8_t id, uint16_t x, uint16_t y)
+{
+    sprite_t *sprite;
+    sprite_rect_t old;
+    bool had_old;
+
+    if (id >= SPRITE_COUNT)
+    {
+        return;
+    }
+
+    sprite = &sprites[id];
+
+    if ((sprite->x == x) && (sprite->y == y))
+    {
+        return;
+    }
+
+    had_old = sprite_bounds(sprite, &old);
+
+    sprite->x = x;
+    sprite->y = y;
+
+    redraw(id, &old, had_old);
+}
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Sprite initialisation
+ */
+void sprite_init(void)
+{
+    uint8_t id;
+
+    memset(&sprite_info, 0, sizeof(sprite_info));
+    memset(&sprites[0], 0, sizeof(sprites));
+
+    for (id = 0; id < SPRITE_COUNT; id++)
+    {
+        sprite_info.order[id] = id;
+    }
+}
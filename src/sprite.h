@@ -0,0 +1,74 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  sprite.h
+ *
+ *    Description:  Sprite header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 11:57:40 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef SPRITE_H
+#define SPRITE_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+
+/*-----------------------------------------------------------------------------
+ *  Types
+ *-----------------------------------------------------------------------------*/
+
+/* Image, position and background of a sprite */
+typedef struct
+{
+    /* Top left corner of the image in the atlas and its size */
+    uint16_t sx;
+    uint16_t sy;
+    uint8_t  width;
+    uint8_t  height;
+
+    /* Screen position of the top left corner */
+    uint16_t x;
+    uint16_t y;
+
+    /* Higher z is drawn over lower z */
+    uint8_t  z;
+
+    /* Background: the tile map (bgcolor outside the map), or bgcolor */
+    uint16_t bgcolor;
+    bool     tile_bg;
+
+    /* Sprite is drawn */
+    bool     visible;
+} sprite_params_t;
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+bool sprite_load_begin(uint16_t width, uint16_t height, uint8_t bpp);
+void sprite_load(uint8_t byte);
+bool sprite_set(uint8_t id, const sprite_params_t *params);
+void sprite_move(uint8_t id, uint16_t x, uint16_t y);
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+void sprite_init(void);
+
+#endif
@@ -25,6 +25,10 @@
 /* Local includes */
 #include "tft.h"
 #include "fonts.h"
+#include "font_runs.h"
+#include "asset_tables.h"
+#include "scratch.h"
+#include "setting.h"
 #include "ringbuf.h"
 
 /*-----------------------------------------------------------------------------
@@ -49,6 +53,22 @@
 /* Command info TFT data size */
 #define CMD_DATA_SIZE       (4096)
 
+/* Solid fills from this size on are sent by uDMA */
+#define DMA_MIN_PIXELS      (32U)
+
+/* MADCTL bits: row address order and row/column exchange */
+#define MADCTL_MY           (0x80)
+#define MADCTL_MV           (0x20)
+
+/* CASET/PASET command byte plus 4 parameter bytes */
+#define ADDRESS_SET_BYTES   (5U)
+
+/* Pixel col of a 1-bpp row, MSB first */
+#define MASK_BIT(bits, col) (((bits)[(col) >> 3] >> (7 - ((col) & 0x07))) & 0x01)
+
+/* Glyph cache pool size (pixels) */
+#define GLYPH_CACHE_PIXELS  (GLYPH_CACHE_SIZE / sizeof(uint16_t))
+
 /* pin mapping for RST tft */ 
 #define RST_PIN_BASE        GPIO_PORTE_BASE
 #define RST_PIN             GPIO_PIN_3
@@ -94,9 +114,11 @@
 #define PASETP      0x2B
 #define RAMWRP      0x2C
 #define RGBSET      0x2D
+#define VSCRDEF     0x33
 #define MADCTL      0x36
-#define SEP         0x37
+#define SEP         0x37        /* Vertical Scrolling Start Address */
 #define COLMOD      0x3A
+#define RAMWRC      0x3C
 #define DISCTR      0xB9
 #define DOR         0xBA
 #define EC          0xC0
@@ -193,13 +215,144 @@ typedef struct
 
     /* Orientation mode */
     uint8_t  orientation;
+
+    /* Image transfer: high byte waiting for its low byte */
+    uint8_t  image_high_byte;
+
+    /* Image transfer: image_high_byte holds a valid byte */
+    bool     image_byte_pending;
+
+    /* Transaction is waiting for uDMA to complete before releasing CS */
+    bool     stream_pending;
+
+    /* D/C pin is high (data phase) */
+    bool     dc_data;
+
+    /* uDMA source of a solid fill (non-incrementing) */
+    uint16_t fill_color;
+
+    /* Last programmed column and page address (CASET/PASET) */
+    uint16_t win_x0;
+    uint16_t win_x1;
+    uint16_t win_y0;
+    uint16_t win_y1;
+
+    /* win_x0/win_x1 and win_y0/win_y1 match the controller */
+    bool     column_valid;
+    bool     page_valid;
+
+    /* GRAM write cursor within the programmed window */
+    uint16_t cursor_x;
+    uint16_t cursor_y;
+
+    /* cursor_x/cursor_y match the controller */
+    bool     cursor_valid;
+
+    /* Command and parameter bytes not sent thanks to the window cache */
+    uint32_t saved_bytes;
+
+    /* Glyph line buffer to be filled next */
+    uint8_t  glyph_line_index;
 } tft_info_t;
 
+/* Terminal (hardware vertical scrolling) */
+typedef struct
+{
+    /* Terminal mode is on */
+    bool     active;
+
+    /* Top fixed area (GRAM rows above the scroll area) */
+    uint16_t top;
+
+    /* Text rows in the scroll area and their height */
+    uint16_t rows;
+    uint16_t line_height;
+
+    /* Characters per row */
+    uint16_t columns;
+
+    uint16_t size;
+    uint16_t fgcolor;
+    uint16_t bgcolor;
+
+    /* Row slot being written (0 - rows - 1) and its next column */
+    uint16_t slot;
+    uint16_t column;
+
+    /* Rows started since the terminal was started */
+    uint32_t lines;
+
+    /* A new row is started before the next character */
+    bool     newline;
+} terminal_info_t;
+
+/* Hardware scroll of a screen band (see tft_scroll_begin) */
+typedef struct
+{
+    /* Band is scrolled */
+    bool     active;
+
+    /* First screen line and number of lines of the band */
+    uint16_t start;
+    uint16_t length;
+
+    /* First GRAM row of the band (VSCRDEF top fixed area) */
+    uint16_t top;
+
+    /* GRAM row shown first, relative to top */
+    uint16_t offset;
+
+    /* Screen lines run opposite to GRAM rows */
+    bool     mirrored;
+} scroll_info_t;
+
+/* Glyph cache entry: the 8 font rows of a glyph scaled to its width */
+typedef struct
+{
+    /* Key (size 0xff if unused) */
+    uint8_t  ascii;
+    uint8_t  size;
+    uint16_t fgcolor;
+    uint16_t bgcolor;
+
+    /* First pixel in glyph_cache_pool */
+    uint16_t offset;
+
+    /* Tick of last use (least recently used is evicted first) */
+    uint32_t last_used;
+} glyph_entry_t;
+
+/* Glyph cache */
+typedef struct
+{
+    glyph_entry_t entry[GLYPH_CACHE_ENTRIES];
+
+    /* Pixels used in glyph_cache_pool (entries are packed from the start) */
+    uint32_t used;
+
+    uint32_t tick;
+
+    /* Lookups of cacheable glyphs */
+    uint32_t hits;
+    uint32_t misses;
+} glyph_cache_t;
+
 /*-----------------------------------------------------------------------------
  *  Private Data
  *-----------------------------------------------------------------------------*/
 
 static tft_info_t       tft_info;
+
+/* Line buffers (scaled glyph rows, flash asset pixels), one is rebuilt
+ * while uDMA may still send the other */
+static uint16_t         glyph_line[2][TFT_HEIGHT];
+
+static terminal_info_t  terminal_info;
+static scroll_info_t    scroll_info;
+
+/* Pre-expanded glyphs, ready to stream (pool in the scratch memory) */
+static glyph_cache_t    glyph_cache;
+static uint16_t         *glyph_cache_pool;
 #if NON_BLOCKING
 static cmd_queue_t      cmd_queue;
 #endif
@@ -268,6 +421,17 @@ static bool cmd_queue_read(tft_cmd_info_t *cmd_info)
 }
 #endif
 
+/**
+ * @brief   Forget the programmed window and write cursor
+ *          Called whenever the controller state is not known anymore
+ */
+static void invalidate_window(void)
+{
+    tft_info.column_valid = false;
+    tft_info.page_valid = false;
+    tft_info.cursor_valid = false;
+}
+
 /**
  * @brief   Initialize TFT hardware setting
  *          SPI initialization
@@ -282,6 +446,9 @@ static void hw_init(void)
     GPIOPinTypeGPIOOutput(DC_PIN_BASE, DC_PIN);
 
     CLEAR_DC_PIN;
+    tft_info.dc_data = false;
+
+    invalidate_window();
 
     /* Set RST pin as output */
     GPIOPinTypeGPIOOutput(RST_PIN_BASE, RST_PIN);
@@ -301,18 +468,146 @@ static void hw_init(void)
 }
 
 /**
- * @brief   Send command
- * @param   cmd     TFT Command
+ * @brief   Drive D/C pin, only toggling it when the phase changes
+ * @param   data    True for data phase, false for command phase
  */
-void tft_send_command(uint8_t cmd)
+static void set_dc(bool data)
 {
-    CLEAR_DC_PIN;
+    if (tft_info.dc_data != data)
+    {
+        /* Frames still in flight must be sampled with the old phase */
+        spi_flush(SPI_TFT);
+
+        if (data)
+        {
+            SET_DC_PIN;
+        }
+        else
+        {
+            CLEAR_DC_PIN;
+        }
+
+        tft_info.dc_data = data;
+    }
+}
+
+/**
+ * @brief   Release CS once the last frame is shifted out
+ *          Restore 8-bit frames for commands
+ */
+static void close_stream(void)
+{
+    spi_flush(SPI_TFT);
+
+    spi_set_data_width(SPI_TFT, SPI_DATA_WIDTH_8);
+
+    SET_CS_PIN;
+
+    tft_info.stream_pending = false;
+}
+
+/**
+ * @brief   Wait for a uDMA pixel stream to complete before touching CS/DC
+ */
+static void wait_ready(void)
+{
+    if (tft_info.stream_pending)
+    {
+        close_stream();
+    }
+}
+
+/**
+ * @brief   Begin transaction by asserting CS
+ *          CS stays low for every command and data written until
+ *          tft_end_transaction
+ */
+void tft_begin_transaction(void)
+{
+    wait_ready();
 
     CLEAR_CS_PIN;
+}
+
+/**
+ * @brief   Write command byte within a transaction (window cache untouched)
+ * @param   cmd     TFT Command
+ */
+static void write_command(uint8_t cmd)
+{
+    set_dc(false);
+
+    /* Commands are always 8-bit frames */
+    spi_set_data_width(SPI_TFT, SPI_DATA_WIDTH_8);
 
     spi_write(SPI_TFT, cmd);
+}
 
-    SET_CS_PIN;
+/**
+ * @brief   Write data bytes within a transaction (window cache untouched)
+ * @param   data    Data
+ * @param   size    Data size
+ */
+static void write_data(const uint8_t *data, uint32_t size)
+{
+    ASSERT(data != NULL);
+
+    set_dc(true);
+
+    spi_write_burst(SPI_TFT, data, size);
+}
+
+/**
+ * @brief   Write command byte within a transaction
+ *          The command may move the window or the write cursor, so the
+ *          window cache is dropped
+ * @param   cmd     TFT Command
+ */
+void tft_write_command(uint8_t cmd)
+{
+    invalidate_window();
+
+    write_command(cmd);
+}
+
+/**
+ * @brief   Write data bytes within a transaction
+ * @param   data    Data
+ * @param   size    Data size
+ */
+void tft_write_data(const uint8_t *data, uint32_t size)
+{
+    /* Unknown number of pixels may be written to GRAM */
+    tft_info.cursor_valid = false;
+
+    write_data(data, size);
+}
+
+/**
+ * @brief   End transaction by releasing CS
+ *          If uDMA is still sending, CS is released from the transmit
+ *          complete callback or before the next transaction, whichever is
+ *          first
+ */
+void tft_end_transaction(void)
+{
+    tft_info.stream_pending = true;
+
+    if (!spi_busy(SPI_TFT))
+    {
+        close_stream();
+    }
+}
+
+/**
+ * @brief   Send command
+ * @param   cmd     TFT Command
+ */
+void tft_send_command(uint8_t cmd)
+{
+    tft_begin_transaction();
+    tft_write_command(cmd);
+    tft_end_transaction();
 }
 
 /**
@@ -322,13 +617,9 @@ void tft_send_command(uint8_t cmd)
  */
 void tft_send_data(uint8_t data)
 {
-    SET_DC_PIN;
-
-    CLEAR_CS_PIN;
-
-    spi_write(SPI_TFT, data);
-
-    SET_CS_PIN;
+    tft_begin_transaction();
+    tft_write_data(&data, 1);
+    tft_end_transaction();
 }
 
 #if NON_BLOCKING
@@ -353,162 +644,883 @@ static void send_command_struct(tft_cmd_info_t* cmd_info)
 #endif
 
 /**
- * @brief   Send word (16-bit)
+ * @brief   Write word (16-bit) within a transaction
  *
  * @param   word    data (16-bit)
  */
-static void send_word(uint16_t word)
+static void write_word(uint16_t word)
 {
-    uint8_t high_byte = word>>8;
-    uint8_t low_byte = word&0xff;
+    uint8_t bytes[2];
 
-    SET_DC_PIN;
+    bytes[0] = word >> 8;
+    bytes[1] = word & 0xff;
 
-    CLEAR_CS_PIN;
+    write_data(&bytes[0], sizeof(bytes));
+}
+
+/**
+ * @brief   Write a start/end address pair within a transaction
+ * @param   cmd     CASETP or PASETP
+ * @param   start   Start address
+ * @param   end     End address
+ */
+static void write_address(uint8_t cmd, uint16_t start, uint16_t end)
+{
+    uint8_t bytes[4];
 
-    spi_write(SPI_TFT, high_byte);
-    spi_write(SPI_TFT, low_byte);
+    bytes[0] = start >> 8;
+    bytes[1] = start & 0xff;
+    bytes[2] = end >> 8;
+    bytes[3] = end & 0xff;
 
-    SET_CS_PIN;
+    write_command(cmd);
+    write_data(&bytes[0], sizeof(bytes));
 }
 
 /**
- * @brief   Set column
+ * @brief   Set column, skipped if the column address is already programmed
  * @param   start_column    Starting position of the column
  * @param   end_column      End position of the column
  */
 static void set_column(uint16_t start_column,uint16_t end_column)
 {
-    tft_send_command(CASETP);              /* Column Address Set */
-    send_word(start_column);
-    send_word(end_column);
+    if (tft_info.column_valid &&
+        (tft_info.win_x0 == start_column) &&
+        (tft_info.win_x1 == end_column))
+    {
+        tft_info.saved_bytes += ADDRESS_SET_BYTES;
+    }
+    else
+    {
+        write_address(CASETP, start_column, end_column);   /* Column Address Set */
+
+        tft_info.win_x0 = start_column;
+        tft_info.win_x1 = end_column;
+        tft_info.column_valid = true;
+    }
 }
 
 /**
- * @brief   Set page
+ * @brief   Set page, skipped if the page address is already programmed
  * @param   StartPage   Starting position of the page
  * @param   EndPage     End position of the page
  */
 static void set_page(uint16_t StartPage,uint16_t EndPage)
 {
-    tft_send_command(PASETP);              /* Page Address Set */
-    send_word(StartPage);
-    send_word(EndPage);
+    if (tft_info.page_valid &&
+        (tft_info.win_y0 == StartPage) &&
+        (tft_info.win_y1 == EndPage))
+    {
+        tft_info.saved_bytes += ADDRESS_SET_BYTES;
+    }
+    else
+    {
+        write_address(PASETP, StartPage, EndPage);         /* Page Address Set */
+
+        tft_info.win_y0 = StartPage;
+        tft_info.win_y1 = EndPage;
+        tft_info.page_valid = true;
+    }
 }
 
 /**
- * @brief   Set starting position of x and y
- * @param   x   x coordinate
- * @param   y   y coordinate
+ * @brief   Check whether the pixels of (x0, y0) to (x1, y1) in write order
+ *          follow the write cursor of the programmed window
+ *          True for a run along the cursor row, or for full window rows
+ *          starting at the cursor
+ * @param   x0  x-position for top left position
+ * @param   y0  y-position for top left position
+ * @param   x1  x-position for bottom right position
+ * @param   y1  y-position for bottom right position
+ * @return  True if memory write can continue at the cursor
  */
-static void set_xy(uint16_t x, uint16_t y)
+static bool window_continues(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
-    set_column(x, x);
-    set_page(y, y);
-    tft_send_command(RAMWRP);              /* Memory Write */
+    bool result = false;
+
+    if (tft_info.column_valid && tft_info.page_valid && tft_info.cursor_valid &&
+        (tft_info.cursor_x == x0) && (tft_info.cursor_y == y0))
+    {
+        if ((y0 == y1) && (x0 <= x1) && (x1 <= tft_info.win_x1))
+        {
+            result = true;
+        }
+        else if ((x0 == tft_info.win_x0) && (x1 == tft_info.win_x1) &&
+                 (y0 <= y1) && (y1 <= tft_info.win_y1))
+        {
+            result = true;
+        }
+    }
+
+    return result;
 }
-/*-----------------------------------------------------------------------------
- *  Event call-backs
- *-----------------------------------------------------------------------------*/
 
-#if NON_BLOCKING
-static void tft_state_cmd(void)
+/**
+ * @brief   Advance the write cursor by count pixels (wraps within window)
+ * @param   count   Number of pixels written
+ */
+static void advance_cursor(uint32_t count)
 {
-    tft_cmd_info_t cmd_info;
+    uint32_t width;
+    uint32_t height;
+    uint32_t offset;
 
-    ASSERT(tft_info.send_state == STATE_CMD);
-    ASSERT(tft_info.state == TFT_BUSY);
+    if (tft_info.cursor_valid)
+    {
+        width = tft_info.win_x1 - tft_info.win_x0 + 1;
+        height = tft_info.win_y1 - tft_info.win_y0 + 1;
 
-    CLEAR_DC_PIN;
+        offset = (tft_info.cursor_y - tft_info.win_y0) * width +
+                 (tft_info.cursor_x - tft_info.win_x0);
+        offset = (offset + count) % (width * height);
 
-    bool result = cmd_queue_read(&cmd_info);
+        tft_info.cursor_x = tft_info.win_x0 + (offset % width);
+        tft_info.cursor_y = tft_info.win_y0 + (offset / width);
+    }
+}
 
-    /* Contain queue */
-    if (result)
+/**
+ * @brief   Set address window and start memory write within a transaction
+ *          Unchanged column/page addresses are not sent again, and memory
+ *          write continues (RAMWRC) when the window starts at the cursor
+ * @param   x0  x-position for top left position
+ * @param   y0  y-position for top left position
+ * @param   x1  x-position for bottom right position
+ * @param   y1  y-position for bottom right position
+ */
+static void set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    if (window_continues(x0, y0, x1, y1))
     {
-        send_command_struct(&cmd_info);
+        write_command(RAMWRC);              /* Memory Write Continue */
+
+        tft_info.saved_bytes += 2 * ADDRESS_SET_BYTES;
     }
     else
     {
-        /* No more data */
-        tft_info.state = TFT_READY;
-
-        /* Callback to when TFT is READY */
-        tft_info.done_cb();
+        set_column(x0, x1);
+        set_page(y0, y1);
+        write_command(RAMWRP);              /* Memory Write */
+
+        /* Invalid window (start > end) leaves the cursor unknown */
+        tft_info.cursor_x = x0;
+        tft_info.cursor_y = y0;
+        tft_info.cursor_valid = (x0 <= x1) && (y0 <= y1);
     }
 }
 
-static void tft_state_data(void)
+/**
+ * @brief   Start RAMWR pixel payload within a transaction
+ *          Switch to data phase and to 16-bit frames so one RGB565 pixel is
+ *          one FIFO entry, the transaction end restores 8-bit frames
+ */
+static void pixel_stream_begin(void)
 {
-    uint32_t size = tft_info.last_cmd.size;
-    uint32_t read_size;
-    uint8_t data[64];
-
-    ASSERT(tft_info.send_state == STATE_DATA);
-    ASSERT(tft_info.state == TFT_BUSY);
+    set_dc(true);
 
-    SET_DC_PIN;
+    spi_set_data_width(SPI_TFT, SPI_DATA_WIDTH_16);
+}
 
-    while (size)
+/**
+ * @brief   Stream the same colour for count pixels
+ *          Must be called after pixel_stream_begin, within a transaction
+ * @param   color   Colour (16-bit)
+ * @param   count   Number of pixels
+ */
+static void stream_color(uint16_t color, uint32_t count)
+{
+    if (count >= DMA_MIN_PIXELS)
     {
-        if (size <= 64)
-        {
-            read_size = size;
-            RingBufRead(&tft_info.data_ringbuf_obj, &data[0], read_size);
-        }
-        /* Expected size more than 64 bytes */
-        else
-        {
-            read_size = 64;
-            RingBufRead(&tft_info.data_ringbuf_obj, &data[0], read_size);
-        }
+        /* Non-incrementing 2-byte source, one 16-bit frame per pixel.
+         * A previous fill may still be reading it */
+        while (spi_busy(SPI_TFT));
 
-        spi_write_non_blocking(SPI_TFT, &data[0], size);
-        size -= read_size;
+        tft_info.fill_color = color;
+        spi_write_dma(SPI_TFT, &tft_info.fill_color, count, false);
+    }
+    else if (count > 0)
+    {
+        spi_write_repeat(SPI_TFT, color, count);
     }
 
-    /* TODO: Handle next state for data */
-    tft_info.send_state = STATE_CMD;
+    advance_cursor(count);
 }
-#endif
 
-/* Callback from SPI when transmission completed */
-static void spi_tx_cb(void)
+/**
+ * @brief   Stream count pixels from a buffer
+ *          Must be called after pixel_stream_begin, within a transaction.
+ *          Long runs are sent by uDMA: the buffer must not be modified until
+ *          the next TFT call returns
+ * @param   pixels  Pixels (RGB565)
+ * @param   count   Number of pixels
+ */
+static void stream_pixels(const uint16_t *pixels, uint32_t count)
 {
-#if NON_BLOCKING
-    if (tft_info.send_state == STATE_CMD)
+    if (count >= DMA_MIN_PIXELS)
     {
-        tft_state_cmd();
+        spi_write_dma(SPI_TFT, pixels, count, true);
     }
-    else
+    else if (count > 0)
     {
-        tft_state_data();
+        spi_write_words(SPI_TFT, pixels, count);
     }
-#endif
-}
-
-
-/*-----------------------------------------------------------------------------
- *  Services
- *-----------------------------------------------------------------------------*/
-#if NON_BLOCKING
-static void tft_register_done_callback(tft_done_cb_t tft_done_cb)
-{
-    ASSERT(tft_done_cb != NULL);
 
-    tft_info.done_cb = tft_done_cb;
+    advance_cursor(count);
 }
-#endif
 
+#if ASSET_TABLE_COUNT > 0
 /**
- * @brief   Send raw message packet
- * @param   cmd     Command
- * @param   data    Data (8-bit)
- * @param   size    Data size
+ * @brief   Stream count pixels from flash
+ *          Must be called after pixel_stream_begin, within a transaction.
+ *          uDMA cannot read flash, so long blocks are copied into the line
+ *          buffers in turn, each one is sent while the next one is copied
+ * @param   pixels  Pixels (RGB565) in flash
+ * @param   count   Number of pixels
  */
-void tft_send_raw(uint8_t    cmd,
-                  uint8_t*   data,
-                  uint32_t   size)
+static void stream_flash_pixels(const uint16_t *pixels, uint32_t count)
+{
+    uint16_t *line;
+    uint32_t chunk;
+
+    if (count < DMA_MIN_PIXELS)
+    {
+        /* Short blocks go through the FIFO, read from flash directly */
+        stream_pixels(pixels, count);
+        return;
+    }
+
+    while (count > 0)
+    {
+        chunk = min(count, TFT_HEIGHT);
+
+        line = &glyph_line[tft_info.glyph_line_index][0];
+        tft_info.glyph_line_index ^= 1;
+
+        memcpy(line, pixels, chunk * sizeof(uint16_t));
+        stream_pixels(line, chunk);
+
+        pixels += chunk;
+        count -= chunk;
+    }
+}
+
+/**
+ * @brief   Stream one row of an RLE asset
+ *          Must be called after pixel_stream_begin, within a transaction
+ * @param   data    First token of the row
+ * @param   width   Asset width
+ * @param   visible Pixels of the row inside the window (0 - width)
+ * @return  First token of the next row
+ */
+static const uint16_t *stream_rle_row(const uint16_t *data,
+                                      uint16_t width, uint16_t visible)
+{
+    uint16_t col = 0;
+    uint16_t count;
+    uint16_t shown;
+    bool     run;
+
+    while (col < width)
+    {
+        run = (*data & TFT_ASSET_RUN) != 0;
+        count = *data++ & ~TFT_ASSET_RUN;
+
+        ASSERT(count > 0);
+
+        shown = (col < visible) ? min(count, visible - col) : 0;
+
+        if (run)
+        {
+            stream_color(*data, shown);
+            data++;
+        }
+        else
+        {
+            stream_flash_pixels(data, shown);
+            data += count;
+        }
+
+        col += count;
+    }
+
+    return data;
+}
+#endif
+
+/**
+ * @brief   Font cell covering a pixel offset in a scaled glyph
+ *          Cells are (size + 1) pixels wide and overlap by one pixel (see
+ *          tft_fill_rectangle), the later cell wins
+ * @param   offset  Pixel offset from glyph origin (0 - 8 * size)
+ * @param   size    Font size
+ * @return  Cell index (0 - 7)
+ */
+static uint8_t glyph_cell(uint16_t offset, uint16_t size)
+{
+    uint8_t cell = 7;
+
+    if (size > 0)
+    {
+        cell = min(offset / size, 7);
+    }
+
+    return cell;
+}
+
+/**
+ * @brief   Expand font row f of a glyph to the scaled width
+ * @param   line    Output pixels (width)
+ * @param   glyph   Glyph (font_map entry)
+ * @param   f       Font row (0 - 7)
+ * @param   width   Pixels to expand from the glyph origin
+ * @param   size    Font size
+ * @param   fgcolor Foreground colour (16-bit)
+ * @param   bgcolor Background colour (16-bit)
+ */
+static void glyph_expand(uint16_t *line, const uint8_t *glyph, uint8_t f,
+                         uint16_t width, uint16_t size,
+                         uint16_t fgcolor, uint16_t bgcolor)
+{
+    uint16_t col;
+
+    for (col = 0; col < width; col++)
+    {
+        if ((glyph[glyph_cell(col, size)] >> f) & 0x01)
+        {
+            line[col] = fgcolor;
+        }
+        else
+        {
+            line[col] = bgcolor;
+        }
+    }
+}
+
+/**
+ * @brief   Empty the glyph cache (hit and miss counts are kept)
+ */
+static void glyph_cache_clear(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < GLYPH_CACHE_ENTRIES; i++)
+    {
+        glyph_cache.entry[i].size = 0xff;
+    }
+
+    glyph_cache.used = 0;
+    glyph_cache.tick = 0;
+}
+
+/**
+ * @brief   Drop a glyph cache entry and pack the pool
+ * @param   index   Entry index
+ */
+static void glyph_cache_evict(uint8_t index)
+{
+    glyph_entry_t *entry = &glyph_cache.entry[index];
+    uint32_t length = TFT_FONT_Y * (TFT_FONT_X * entry->size + 1);
+    uint8_t i;
+
+    memmove(&glyph_cache_pool[entry->offset],
+            &glyph_cache_pool[entry->offset + length],
+            (glyph_cache.used - entry->offset - length) * sizeof(uint16_t));
+
+    for (i = 0; i < GLYPH_CACHE_ENTRIES; i++)
+    {
+        if ((glyph_cache.entry[i].size != 0xff) &&
+            (glyph_cache.entry[i].offset > entry->offset))
+        {
+            glyph_cache.entry[i].offset -= length;
+        }
+    }
+
+    glyph_cache.used -= length;
+    entry->size = 0xff;
+}
+
+/**
+ * @brief   Find a scaled glyph in the cache, expanding it on a miss
+ *          A miss packs the pool, so no uDMA stream may be reading it
+ *          (call within a transaction)
+ * @param   ascii   Character (32 - 127)
+ * @param   size    Font size
+ * @param   fgcolor Foreground colour (16-bit)
+ * @param   bgcolor Background colour (16-bit)
+ * @return  Font rows 0 - 7, each (8 * size + 1) pixels, or NULL if the size
+ *          is not cached
+ */
+static const uint16_t *glyph_cache_lookup(uint8_t ascii, uint16_t size,
+                                          uint16_t fgcolor, uint16_t bgcolor)
+{
+    glyph_entry_t *entry;
+    uint16_t width = TFT_FONT_X * size + 1;
+    uint32_t length = TFT_FONT_Y * width;
+    uint8_t  lru = 0;
+    uint8_t  free_index;
+    uint8_t  i, f;
+
+    if (size > GLYPH_CACHE_MAX_SIZE)
+    {
+        return NULL;
+    }
+
+    /* The pool is in the scratch memory, another user may have taken it */
+    if (scratch_owner() != SCRATCH_GLYPH_CACHE)
+    {
+        glyph_cache_pool = scratch_claim(SCRATCH_GLYPH_CACHE,
+                                         GLYPH_CACHE_SIZE);
+        glyph_cache_clear();
+    }
+
+    glyph_cache.tick++;
+
+    for (i = 0; i < GLYPH_CACHE_ENTRIES; i++)
+    {
+        entry = &glyph_cache.entry[i];
+
+        if ((entry->ascii == ascii) &&
+            (entry->size == size) &&
+            (entry->fgcolor == fgcolor) &&
+            (entry->bgcolor == bgcolor))
+        {
+            entry->last_used = glyph_cache.tick;
+            glyph_cache.hits++;
+
+            return &glyph_cache_pool[entry->offset];
+        }
+    }
+
+    glyph_cache.misses++;
+
+    /* Evict least recently used entries until both a slot and pool space
+     * are free */
+    while (1)
+    {
+        free_index = GLYPH_CACHE_ENTRIES;
+
+        for (i = 0; i < GLYPH_CACHE_ENTRIES; i++)
+        {
+            if (glyph_cache.entry[i].size == 0xff)
+            {
+                free_index = i;
+            }
+            else if ((glyph_cache.entry[lru].size == 0xff) ||
+                     (glyph_cache.entry[i].last_used <
+                      glyph_cache.entry[lru].last_used))
+            {
+                lru = i;
+            }
+        }
+
+        if ((free_index < GLYPH_CACHE_ENTRIES) &&
+            (glyph_cache.used + length <= GLYPH_CACHE_PIXELS))
+        {
+            break;
+        }
+
+        glyph_cache_evict(lru);
+    }
+
+    entry = &glyph_cache.entry[free_index];
+    entry->ascii = ascii;
+    entry->size = size;
+    entry->fgcolor = fgcolor;
+    entry->bgcolor = bgcolor;
+    entry->offset = glyph_cache.used;
+    entry->last_used = glyph_cache.tick;
+
+    glyph_cache.used += length;
+
+    for (f = 0; f < TFT_FONT_Y; f++)
+    {
+        glyph_expand(&glyph_cache_pool[entry->offset + f * width],
+                     font_map[ascii - 0x20], f, width, size,
+                     fgcolor, bgcolor);
+    }
+
+    return &glyph_cache_pool[entry->offset];
+}
+
+/**
+ * @brief   Draw the left part of a glyph at (x,y) with foreground and
+ *          background colour
+ * @param   ascii    ASCII Character. eg: 'A'
+ * @param   x        Starting x position
+ * @param   y        Starting y position
+ * @param   size     Size of the font
+ * @param   fgcolor  Foreground colour
+ * @param   bgcolor  Background colour
+ * @param   width    Columns drawn from the glyph origin (1 - 8 * size + 1)
+ */
+static void draw_char(uint8_t ascii, uint16_t x, uint16_t y,
+                      uint16_t size, uint16_t fgcolor, uint16_t bgcolor,
+                      uint16_t width)
+{
+    const uint8_t *glyph;
+    const uint16_t *cached;
+    const uint16_t *line = NULL;
+    uint16_t *buffer;
+    uint16_t x1, y1;
+    uint16_t row;
+    uint8_t  f;
+    uint8_t  line_f = TFT_FONT_Y;
+
+    if((ascii < 32) || (ascii > 127))
+    {
+        ascii = '?';
+    }
+
+    glyph = font_map[ascii-0x20];
+
+    if ((x > tft_info.max_x) || (y > tft_info.max_y))
+    {
+        return;
+    }
+
+    /* Glyph is (8 * size + 1) square, clipped to width and to the screen */
+    x1 = min((uint32_t)x + width - 1, tft_info.max_x);
+    y1 = min((uint32_t)y + TFT_FONT_Y * size, tft_info.max_y);
+
+    tft_begin_transaction();
+
+    /* Looked up within the transaction: no uDMA stream reads the cache */
+    cached = glyph_cache_lookup(ascii, size, fgcolor, bgcolor);
+
+    set_window(x, y, x1, y1);
+
+    pixel_stream_begin();
+
+    for (row = 0; row <= (y1 - y); row++)
+    {
+        f = glyph_cell(row, size);
+
+        if (cached != NULL)
+        {
+            /* Clipped glyphs send the left part of each cached row */
+            line = &cached[f * (TFT_FONT_X * size + 1)];
+        }
+        else if (f != line_f)
+        {
+            /* Expand font row f to the scaled width */
+            buffer = &glyph_line[tft_info.glyph_line_index][0];
+            tft_info.glyph_line_index ^= 1;
+
+            glyph_expand(buffer, glyph, f, x1 - x + 1, size,
+                         fgcolor, bgcolor);
+
+            line = buffer;
+            line_f = f;
+        }
+
+        stream_pixels(line, x1 - x + 1);
+    }
+
+    tft_end_transaction();
+}
+
+/**
+ * @brief   Program the vertical scroll area (VSCRDEF)
+ * @param   top     Top fixed area (rows)
+ * @param   height  Scroll area (rows)
+ */
+static void set_scroll_area(uint16_t top, uint16_t height)
+{
+    uint16_t bottom = TFT_HEIGHT - top - height;
+    uint8_t data[6];
+
+    data[0] = top >> 8;
+    data[1] = top & 0xff;
+    data[2] = height >> 8;
+    data[3] = height & 0xff;
+    data[4] = bottom >> 8;
+    data[5] = bottom & 0xff;
+
+    tft_begin_transaction();
+    write_command(VSCRDEF);                 /* Vertical Scrolling Definition */
+    write_data(&data[0], sizeof(data));
+    tft_end_transaction();
+}
+
+/**
+ * @brief   Set the GRAM row shown at the top of the scroll area (VSCRSADD)
+ * @param   row     GRAM row
+ */
+static void set_scroll_start(uint16_t row)
+{
+    uint8_t data[2];
+
+    data[0] = row >> 8;
+    data[1] = row & 0xff;
+
+    tft_begin_transaction();
+    write_command(SEP);                     /* Vertical Scrolling Start */
+    write_data(&data[0], sizeof(data));
+    tft_end_transaction();
+}
+
+/**
+ * @brief   Start a new terminal row
+ *          The oldest row slot is reused: only that row is cleared, then the
+ *          scroll start moves so it is shown at the bottom
+ */
+static void terminal_new_line(void)
+{
+    terminal_info_t *term = &terminal_info;
+    uint16_t y;
+
+    if (term->lines > 0)
+    {
+        term->slot = (term->slot + 1) % term->rows;
+    }
+
+    term->lines++;
+    term->column = 0;
+
+    y = term->top + term->slot * term->line_height;
+    tft_fill_area(0, y, tft_info.max_x, y + term->line_height - 1,
+                  term->bgcolor);
+
+    /* Once every slot is used, the row after this one is the oldest */
+    if (term->lines > term->rows)
+    {
+        set_scroll_start(term->top +
+                         ((term->slot + 1) % term->rows) * term->line_height);
+    }
+}
+
+/**
+ * @brief   Write one pixel within a transaction
+ * @param   x       X coordinate
+ * @param   y       Y coordinate
+ * @param   color   Colour (16-bit)
+ */
+static void write_pixel(uint16_t x, uint16_t y, uint16_t color)
+{
+    set_window(x, y, x, y);
+    write_word(color);
+
+    advance_cursor(1);
+}
+
+/**
+ * @brief   Write horizontal line within a transaction
+ * @param   x         Starting x coordinate
+ * @param   y         Starting y coordinate
+ * @param   length    Length of the line
+ * @param   color     Colour (16-bit)
+ */
+static void write_horizontal_line(uint16_t x, uint16_t y,
+                                  uint16_t length,
+                                  uint16_t color)
+{
+    set_window(x, y, (x + length), y);
+
+    pixel_stream_begin();
+    stream_color(color, length);
+}
+
+/**
+ * @brief   Write vertical line within a transaction
+ * @param   x         Starting x coordinate
+ * @param   y         Starting y coordinate
+ * @param   length    Length of the line
+ * @param   color     Colour (16-bit)
+ */
+static void write_vertical_line(uint16_t x, uint16_t y,
+                                uint16_t length,
+                                uint16_t color)
+{
+    set_window(x, y, x, (y + length));
+
+    pixel_stream_begin();
+    stream_color(color, length);
+}
+/**
+ * @brief   Write block (x0, y0) to (x1, y1) within a transaction
+ *          (raster_block_t output, clipped to the screen)
+ * @param   x0      Top left x coordinate
+ * @param   y0      Top left y coordinate
+ * @param   x1      Bottom right x coordinate
+ * @param   y1      Bottom right y coordinate
+ * @param   color   Colour (16-bit)
+ */
+static void write_block(int16_t x0, int16_t y0,
+                        int16_t x1, int16_t y1,
+                        uint16_t color)
+{
+    if ((x1 < MIN_X) || (y1 < MIN_Y) ||
+        (x0 > tft_info.max_x) || (y0 > tft_info.max_y))
+    {
+        return;
+    }
+
+    x0 = max(x0, MIN_X);
+    y0 = max(y0, MIN_Y);
+    x1 = min(x1, tft_info.max_x);
+    y1 = min(y1, tft_info.max_y);
+
+    set_window(x0, y0, x1, y1);
+
+    pixel_stream_begin();
+    stream_color(color, (uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1));
+}
+
+/**
+ * @brief   Write one scaled text span within a transaction
+ *          (clipped to the screen)
+ * @param   x0      First x coordinate
+ * @param   x1      Last x coordinate
+ * @param   y       Top row of the glyph row
+ * @param   size    Font size (span is size + 1 rows high)
+ * @param   color   Colour (16-bit)
+ */
+static void write_text_span(uint32_t x0, uint32_t x1, uint32_t y,
+                            uint16_t size, uint16_t color)
+{
+    if ((x0 <= tft_info.max_x) && (y <= tft_info.max_y))
+    {
+        write_block(x0, y,
+                    min(x1, tft_info.max_x), min(y + size, tft_info.max_y),
+                    color);
+    }
+}
+
+/**
+ * @brief   Write line from (x0, y0) to (x1, y1) within a transaction
+ *          Horizontal and vertical lines are one window, other lines are
+ *          grouped into runs with one window per run
+ * @param   x0      Starting point (x)
+ * @param   y0      Starting point (y)
+ * @param   x1      End Point (x)
+ * @param   y1      End Point (y)
+ * @param   color   Colour (16-bit)
+ */
+static void write_line(uint16_t x0, uint16_t y0,
+                       uint16_t x1, uint16_t y1,
+                       uint16_t color)
+{
+    if (y0 == y1)
+    {
+        write_horizontal_line(min(x0, x1), y0, abs(x1 - x0) + 1, color);
+    }
+    else if (x0 == x1)
+    {
+        write_vertical_line(x0, min(y0, y1), abs(y1 - y0) + 1, color);
+    }
+    else
+    {
+        raster_draw_line(write_block, x0, y0, x1, y1, color);
+    }
+}
+/*-----------------------------------------------------------------------------
+ *  Event call-backs
+ *-----------------------------------------------------------------------------*/
+
+#if NON_BLOCKING
+static void tft_state_cmd(void)
+{
+    tft_cmd_info_t cmd_info;
+
+    ASSERT(tft_info.send_state == STATE_CMD);
+    ASSERT(tft_info.state == TFT_BUSY);
+
+    CLEAR_DC_PIN;
+
+    bool result = cmd_queue_read(&cmd_info);
+
+    /* Contain queue */
+    if (result)
+    {
+        send_command_struct(&cmd_info);
+    }
+    else
+    {
+        /* No more data */
+        tft_info.state = TFT_READY;
+
+        /* Callback to when TFT is READY */
+        tft_info.done_cb();
+    }
+}
+
+static void tft_state_data(void)
+{
+    uint32_t size = tft_info.last_cmd.size;
+    uint32_t read_size;
+    uint8_t data[64];
+
+    ASSERT(tft_info.send_state == STATE_DATA);
+    ASSERT(tft_info.state == TFT_BUSY);
+
+    SET_DC_PIN;
+
+    while (size)
+    {
+        if (size <= 64)
+        {
+            read_size = size;
+            RingBufRead(&tft_info.data_ringbuf_obj, &data[0], read_size);
+        }
+        /* Expected size more than 64 bytes */
+        else
+        {
+            read_size = 64;
+            RingBufRead(&tft_info.data_ringbuf_obj, &data[0], read_size);
+        }
+
+        spi_write_non_blocking(SPI_TFT, &data[0], size);
+        size -= read_size;
+    }
+
+    /* TODO: Handle next state for data */
+    tft_info.send_state = STATE_CMD;
+}
+#endif
+
+/* Callback from SPI when transmission completed */
+static void spi_tx_cb(void)
+{
+    /* Release CS of a finished uDMA pixel stream */
+    if (tft_info.stream_pending && !spi_busy(SPI_TFT))
+    {
+        close_stream();
+    }
+
+#if NON_BLOCKING
+    if (tft_info.send_state == STATE_CMD)
+    {
+        tft_state_cmd();
+    }
+    else
+    {
+        tft_state_data();
+    }
+#endif
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+#if NON_BLOCKING
+static void tft_register_done_callback(tft_done_cb_t tft_done_cb)
+{
+    ASSERT(tft_done_cb != NULL);
+
+    tft_info.done_cb = tft_done_cb;
+}
+#endif
+
+/**
+ * @brief   Send raw message packet
+ * @param   cmd     Command
+ * @param   data    Data (8-bit)
+ * @param   size    Data size
+ */
+void tft_send_raw(uint8_t    cmd,
+                  uint8_t*   data,
+                  uint32_t   size)
 {
 #if NON_BLOCKING
     /* Buffer the raw command */
@@ -542,13 +1554,16 @@ void tft_send_raw(uint8_t    cmd,
         send_command_struct(&cmd_info);
     }
 #else
-    uint32_t i;
+    tft_begin_transaction();
 
-    tft_send_command(cmd);
-    for (i = 0; i < size; i++)
+    tft_write_command(cmd);
+
+    if (size > 0)
     {
-        tft_send_data(data[i]);
+        tft_write_data(data, size);
     }
+
+    tft_end_transaction();
 #endif
 }
 
@@ -561,9 +1576,9 @@ void tft_send_raw(uint8_t    cmd,
  */
 void tft_set_area(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
-    set_column(x0, x1);
-    set_page(y0, y1);
-    tft_send_command(RAMWRP);              /* Memory Write */
+    tft_begin_transaction();
+    set_window(x0, y0, x1, y1);
+    tft_end_transaction();
 }
 
 /**
@@ -575,16 +1590,14 @@ void tft_set_area(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
  */
 void tft_start_image_transfer(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
-    if ((tft_info.orientation == ORIENT_H) || (tft_info.orientation == ORIENT_H_I))
-    {
-        tft_set_area(x0, y0, x1, y1);
-    }
-    else
-    {
-        tft_set_area(x0, y0, y1, x1);
-    }
-    CLEAR_CS_PIN;
-    SET_DC_PIN;
+    tft_begin_transaction();
+
+    /* Coordinates are in the current orientation (MADCTL), like any window */
+    set_window(x0, y0, x1, y1);
+
+    tft_info.image_byte_pending = false;
+
+    pixel_stream_begin();
 }
 
 /**
@@ -592,8 +1605,20 @@ void tft_start_image_transfer(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1
  */
 void tft_done_transfer(void)
 {
+    /* Odd trailing byte cannot be sent as a 16-bit frame */
+    if (tft_info.image_byte_pending)
+    {
+        spi_set_data_width(SPI_TFT, SPI_DATA_WIDTH_8);
+        spi_write(SPI_TFT, tft_info.image_high_byte);
+
+        tft_info.image_byte_pending = false;
+
+        /* Half a pixel leaves the cursor unknown */
+        tft_info.cursor_valid = false;
+    }
+
     /* Set CS pin to high to indicate transfer is completed */
-    SET_CS_PIN;
+    tft_end_transaction();
 }
 
 /**
@@ -602,8 +1627,14 @@ void tft_done_transfer(void)
  */
 void tft_set_orientation(uint8_t orientation)
 {
-    tft_send_command(MADCTL);       /* Memory Access Control */
-    tft_send_data(orientation);     /* Refresh Order - BGR colour filter */
+    /* Scrolling follows GRAM rows, it does not survive a rotation */
+    tft_terminal_stop();
+    tft_scroll_end();
+
+    tft_begin_transaction();
+    tft_write_command(MADCTL);              /* Memory Access Control */
+    tft_write_data(&orientation, 1);        /* Refresh Order - BGR colour filter */
+    tft_end_transaction();
 
     tft_info.orientation = orientation;
     if ((orientation == ORIENT_H) || (orientation == ORIENT_H_I))
@@ -632,7 +1663,6 @@ void tft_fill_area(uint16_t x0, uint16_t y0,
                    uint16_t color)
 {
     uint32_t xy=0;
-    uint32_t i=0;
 
     /* Using XOR operator to swap both value */
     if(x0 > x1)
@@ -659,21 +1689,16 @@ void tft_fill_area(uint16_t x0, uint16_t y0,
     xy = (x1 - x0 + 1);
     xy = xy * (y1 - y0 + 1);
 
-    /* Set Coordinate */
-    tft_set_area(x0, y0, x1, y1);
+    tft_begin_transaction();
 
-    SET_DC_PIN;
-    CLEAR_CS_PIN;
+    /* Set Coordinate */
+    set_window(x0, y0, x1, y1);
 
     /* Start Filling area with color */
-    uint8_t high_color = color >> 8;
-    uint8_t low_color = color & 0xff;
-    for(i=0; i < xy; i++)
-    {
-        spi_write(SPI_TFT, high_color);
-        spi_write(SPI_TFT, low_color);
-    }
-    SET_CS_PIN;
+    pixel_stream_begin();
+    stream_color(color, xy);
+
+    tft_end_transaction();
 }
 
 /**
@@ -691,6 +1716,8 @@ void tft_reset(void)
     delay_ms(10);
     SET_RST_PIN;
     delay_ms(500);
+
+    invalidate_window();
 }
 
 /**
@@ -828,8 +1855,9 @@ void tft_start(void)
  */
 void tft_set_pixel(uint16_t x, uint16_t y, uint16_t color)
 {
-    set_xy(x,y);
-    send_word(color);
+    tft_begin_transaction();
+    write_pixel(x, y, color);
+    tft_end_transaction();
 }
 
 /**
@@ -843,13 +1871,9 @@ void tft_draw_horizontal_line(uint16_t x, uint16_t y,
                               uint16_t length,
                               uint16_t color)
 {
-    set_column(x, (x + length));
-    set_page(y, y);
-    tft_send_command(RAMWRP);              /* Memory Write */
-
-    uint16_t i;
-    for(i = 0; i < length; i++)
-        send_word(color);
+    tft_begin_transaction();
+    write_horizontal_line(x, y, length, color);
+    tft_end_transaction();
 }
 
 /**
@@ -863,66 +1887,265 @@ void tft_draw_vertical_line(uint16_t x, uint16_t y,
                             uint16_t length,
                             uint16_t color)
 {
-    set_column(x, x);
-    set_page(y, (y + length));
-    tft_send_command(RAMWRP);              /* Memory Write */
+    tft_begin_transaction();
+    write_vertical_line(x, y, length, color);
+    tft_end_transaction();
+}
+
+/**
+ * @brief   Draw Line from (x0, y0) to (x1, y1) with color
+ *
+ * @param   x0      Starting point (x)
+ * @param   y0      Starting point (x)
+ * @param   x1      End Point (x)
+ * @param   y1      End Point (y)
+ * @param   color   Color (16-bit)
+ */
+void tft_draw_line(uint16_t x0, uint16_t y0,
+                   uint16_t x1, uint16_t y1,
+                   uint16_t color)
+{
+    tft_begin_transaction();
+    write_line(x0, y0, x1, y1, color);
+    tft_end_transaction();
+}
+
+/**
+ * @brief   TFT send data only (without clearing CS pin, setting D/C pin)
+ *          (For image transfer purpose)
+ *          Bytes are paired MSB first and sent as one 16-bit pixel frame
+ * @param   byte    Byte to be transferred
+ */
+void tft_send_data_only(uint8_t byte)
+{
+    if (tft_info.image_byte_pending)
+    {
+        spi_write_word(SPI_TFT, convert_to_word(tft_info.image_high_byte, byte));
+
+        tft_info.image_byte_pending = false;
+
+        advance_cursor(1);
+    }
+    else
+    {
+        tft_info.image_high_byte = byte;
+        tft_info.image_byte_pending = true;
+    }
+}
+
+/**
+ * @brief   TFT send a block of image pixels within an image transfer
+ *          (After tft_start_image_transfer, before tft_done_transfer)
+ *          Pixels are sent by uDMA; the buffer must not be modified until
+ *          the next tft_send_pixels call returns, so callers alternate
+ *          between two buffers (ping-pong)
+ * @param   pixels  Image pixels (RGB565)
+ * @param   count   Number of pixels
+ */
+void tft_send_pixels(const uint16_t *pixels, uint32_t count)
+{
+    ASSERT(pixels != NULL);
+    ASSERT(tft_info.image_byte_pending == false);
+
+    if (count > 0)
+    {
+        spi_write_dma(SPI_TFT, pixels, count, true);
+    }
+
+    advance_cursor(count);
+}
+
+/**
+ * @brief   TFT send count pixels of one colour within an image transfer
+ *          (After tft_start_image_transfer, before tft_done_transfer)
+ * @param   color   Colour (16-bit)
+ * @param   count   Number of pixels
+ */
+void tft_send_color(uint16_t color, uint32_t count)
+{
+    ASSERT(tft_info.image_byte_pending == false);
+
+    stream_color(color, count);
+}
+
+/**
+ * @brief   Write a block of pixels into window (x0, y0) to (x1, y1)
+ *          Pixels are sent by uDMA; the buffer must not be modified until
+ *          the next TFT call returns. count may be less than the window,
+ *          the next block then continues at the write cursor
+ * @param   x0      x-position for top left position
+ * @param   y0      y-position for top left position
+ * @param   x1      x-position for bottom right position
+ * @param   y1      y-position for bottom right position
+ * @param   pixels  Pixels (RGB565) in write order
+ * @param   count   Number of pixels
+ */
+void tft_write_pixels(uint16_t x0, uint16_t y0,
+                      uint16_t x1, uint16_t y1,
+                      const uint16_t *pixels, uint32_t count)
+{
+    ASSERT(pixels != NULL);
+
+    tft_begin_transaction();
+
+    set_window(x0, y0, x1, y1);
+
+    pixel_stream_begin();
+
+    if (count > 0)
+    {
+        spi_write_dma(SPI_TFT, pixels, count, true);
+    }
+
+    advance_cursor(count);
+
+    tft_end_transaction();
+}
+
+/**
+ * @brief   Draw a flash asset with its top left corner at (x, y)
+ *          The asset is clipped to the screen and streamed in one window
+ * @param   id  Asset ID (order of ASSETS in the Makefile)
+ * @param   x   Top left x coordinate
+ * @param   y   Top left y coordinate
+ * @return  False if the asset does not exist
+ */
+bool tft_blit_asset(uint8_t id, uint16_t x, uint16_t y)
+{
+#if ASSET_TABLE_COUNT > 0
+    const tft_asset_t *asset;
+    const uint16_t *data;
+    uint16_t width;
+    uint16_t height;
+    uint16_t row;
+
+    if (id >= ASSET_TABLE_COUNT)
+    {
+        return false;
+    }
+
+    asset = &asset_table[id];
+
+    if ((x > tft_info.max_x) || (y > tft_info.max_y) ||
+        (asset->width == 0) || (asset->height == 0))
+    {
+        return true;
+    }
+
+    width = min(asset->width, tft_info.max_x - x + 1);
+    height = min(asset->height, tft_info.max_y - y + 1);
+
+    tft_begin_transaction();
+
+    set_window(x, y, x + width - 1, y + height - 1);
+
+    pixel_stream_begin();
+
+    if (asset->format == TFT_ASSET_RLE)
+    {
+        data = asset->data;
+
+        for (row = 0; row < height; row++)
+        {
+            data = stream_rle_row(data, asset->width, width);
+        }
+    }
+    else if (width == asset->width)
+    {
+        stream_flash_pixels(asset->data, (uint32_t)width * height);
+    }
+    else
+    {
+        /* Clipped on the right, skip the hidden part of every row */
+        for (row = 0; row < height; row++)
+        {
+            stream_flash_pixels(&asset->data[(uint32_t)row * asset->width],
+                                width);
+        }
+    }
 
-    uint16_t i;
-    for(i = 0; i < length; i++)
-        send_word(color);
+    tft_end_transaction();
+
+    return true;
+#else
+    (void)id;
+    (void)x;
+    (void)y;
+
+    return false;
+#endif
 }
 
 /**
- * @brief   Draw Line from (x0, y0) to (x1, y1) with color
- *
- * @param   x0      Starting point (x)
- * @param   y0      Starting point (x)
- * @param   x1      End Point (x)
- * @param   y1      End Point (y)
- * @param   color   Color (16-bit)
+ * @brief   Draw one row of a 1-bpp mask in rectangle (x0, y0) to (x1, y1)
+ *          Opaque rows are expanded into the glyph line buffers and
+ *          streamed into the rectangle window, rows drawn in order continue
+ *          one memory write. Transparent rows write one span per run of set
+ *          bits (like tft_draw_string_only)
+ * @param   x0          x-position for top left position
+ * @param   y0          y-position for top left position
+ * @param   x1          x-position for bottom right position
+ * @param   y1          y-position for bottom right position
+ * @param   row         Row within the rectangle (0 - y1 - y0)
+ * @param   bits        Row pixels, MSB of bits[0] first
+ * @param   fgcolor     Colour of set bits
+ * @param   bgcolor     Colour of clear bits (opaque only)
+ * @param   transparent Clear bits are not drawn
  */
-void tft_draw_line(uint16_t x0, uint16_t y0,
-                   uint16_t x1, uint16_t y1,
-                   uint16_t color)
+void tft_draw_mask_row(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+                       uint16_t row, const uint8_t *bits,
+                       uint16_t fgcolor, uint16_t bgcolor, bool transparent)
 {
-    int16_t x = x1-x0;
-    int16_t y = y1-y0;
-    int16_t dx = abs(x);
-    int16_t sx = x0<x1 ? 1 : -1;
-    int16_t dy = -abs(y);
-    int16_t sy = y0<y1 ? 1 : -1;
-    int16_t err = dx+dy;
-    int16_t e2;
+    uint16_t *line;
+    uint32_t y = (uint32_t)y0 + row;
+    uint16_t width;
+    uint16_t col;
+    uint16_t run;
+
+    ASSERT(bits != NULL);
+
+    if ((x0 > x1) || (x0 > tft_info.max_x) || (y > y1) || (y > tft_info.max_y))
+    {
+        return;
+    }
+
+    /* Visible part of the row */
+    width = min(x1, tft_info.max_x) - x0 + 1;
+
+    tft_begin_transaction();
 
-    while(1)
+    if (transparent)
     {
-        tft_set_pixel(x0, y0, color);
-        e2 = 2 * err;
-        if (e2 >= dy)
+        for (col = 0; col < width; col++)
         {
-            if(x0 == x1)
-                break;
-            err += dy;
-            x0 += sx;
+            if (MASK_BIT(bits, col))
+            {
+                for (run = col; (run + 1 < width) && MASK_BIT(bits, run + 1); run++);
+
+                write_block(x0 + col, y, x0 + run, y, fgcolor);
+
+                col = run;
+            }
         }
-        if (e2 <= dx)
+    }
+    else
+    {
+        line = &glyph_line[tft_info.glyph_line_index][0];
+        tft_info.glyph_line_index ^= 1;
+
+        for (col = 0; col < width; col++)
         {
-            if (y0 == y1)
-                break;
-            err += dx;
-            y0 += sy;
+            line[col] = MASK_BIT(bits, col) ? fgcolor : bgcolor;
         }
-    } 
-}
 
-/**
- * @brief   TFT send data only (without clearing CS pin, setting D/C pin)
- *          (For image transfer purpose)
- * @param   byte    Byte to be transferred
- */
-void tft_send_data_only(uint8_t byte)
-{
-    spi_write(SPI_TFT, byte);
+        /* Continues the window of the previous row */
+        set_window(x0, y, x0 + width - 1, min(y1, tft_info.max_y));
+
+        pixel_stream_begin();
+        stream_pixels(line, width);
+    }
+
+    tft_end_transaction();
 }
 
 /**
@@ -952,27 +2175,52 @@ void tft_fill_circle(uint16_t xc, uint16_t yc,
                      int16_t r,
                      uint16_t color)
 {
-    int16_t x = -r;
-    int16_t y = 0;
-    int16_t err = 2-2*r;
-    int16_t e2;
+    tft_begin_transaction();
+    raster_fill_circle(write_block, xc, yc, r, color);
+    tft_end_transaction();
+}
 
-    do 
-    {
-        tft_draw_vertical_line(xc-x, yc-y, 2*y, color);
-        tft_draw_vertical_line(xc+x, yc-y, 2*y, color);
+/**
+* @brief    Draw filled Triangle based on Coordinate (x0, y0), (x1, y1) &
+*           (x2, y2)
+* @param    x0      first point (x-coordinate)
+* @param    y0      first point (y-coordinate)
+* @param    x1      second point (x-coordinate)
+* @param    y1      second point (y-coordinate)
+* @param    x2      third point (x-coordinate)
+* @param    y2      third point (y-coordinate)
+* @param    color   Color (16-bit)
+*/
+void tft_fill_triangle(uint16_t x0, uint16_t y0,
+                       uint16_t x1, uint16_t y1,
+                       uint16_t x2, uint16_t y2,
+                       uint16_t color)
+{
+    raster_point_t points[3];
 
-        e2 = err;
-        if (e2 <= y) 
-        {
-            err += ++y * 2 + 1;
-            if (-x == y && e2 <= x) 
-                e2 = 0;
-        }
-        if (e2 > x) 
-            err += ++x * 2 + 1;
-    } while (x <= 0);
+    points[0].x = x0;
+    points[0].y = y0;
+    points[1].x = x1;
+    points[1].y = y1;
+    points[2].x = x2;
+    points[2].y = y2;
 
+    tft_fill_polygon(&points[0], 3, color);
+}
+
+/**
+ * @brief   Draw filled polygon (even-odd rule)
+ * @param   points  Vertices in drawing order (closed implicitly)
+ * @param   count   Number of vertices (3 - RASTER_MAX_VERTICES)
+ * @param   color   Color (16-bit)
+ */
+void tft_fill_polygon(const raster_point_t *points,
+                      uint8_t count,
+                      uint16_t color)
+{
+    tft_begin_transaction();
+    raster_fill_polygon(write_block, points, count, color);
+    tft_end_transaction();
 }
 
 /**
@@ -987,10 +2235,12 @@ void tft_draw_rectangle(uint16_t x, uint16_t y,
                         uint16_t length, uint16_t width,
                         uint16_t color)
 {
-    tft_draw_horizontal_line(x, y, length, color);
-    tft_draw_horizontal_line(x, y + width, length, color);
-    tft_draw_vertical_line(x, y, width, color);
-    tft_draw_vertical_line(x + length, y, width, color);
+    tft_begin_transaction();
+    write_horizontal_line(x, y, length, color);
+    write_horizontal_line(x, y + width, length, color);
+    write_vertical_line(x, y, width, color);
+    write_vertical_line(x + length, y, width, color);
+    tft_end_transaction();
 }
 
 
@@ -1010,9 +2260,11 @@ void tft_draw_triangle(uint16_t x0, uint16_t y0,
                        uint16_t x2, uint16_t y2,
                        uint16_t color)
 {
-    tft_draw_line(x0, y0, x1, y1,color);
-    tft_draw_line(x0, y0, x2, y2,color);
-    tft_draw_line(x1, y1, x2, y2,color);
+    tft_begin_transaction();
+    write_line(x0, y0, x1, y1,color);
+    write_line(x0, y0, x2, y2,color);
+    write_line(x1, y1, x2, y2,color);
+    tft_end_transaction();
 }
 
 /**
@@ -1026,27 +2278,9 @@ void tft_draw_circle(uint16_t xc, uint16_t yc,
                      uint16_t r,
                      uint16_t color)
 {
-    int16_t x = -r;
-    int16_t y = 0;
-    int16_t err = 2 - 2 * r;
-    int16_t e2;
-    
-    do
-    {
-        tft_set_pixel(xc-x, yc+y, color);
-        tft_set_pixel(xc+x, yc+y, color);
-        tft_set_pixel(xc+x, yc-y, color);
-        tft_set_pixel(xc-x, yc-y, color);
-        e2 = err;
-        if (e2 <= y)
-        {
-            err += ++y * 2 + 1;
-            if (-x == y && e2 <= x)
-                e2 = 0;
-        }
-        if (e2 > x)
-            err += ++x * 2 + 1;
-    } while (x <= 0);
+    tft_begin_transaction();
+    raster_draw_circle(write_block, xc, yc, r, color);
+    tft_end_transaction();
 }
 
 /**
@@ -1061,33 +2295,25 @@ void tft_draw_circle(uint16_t xc, uint16_t yc,
 void tft_draw_char(uint8_t ascii, uint16_t x, uint16_t y,
                    uint16_t size, uint16_t fgcolor, uint16_t bgcolor)
 {
-    uint8_t i, f;
+    draw_char(ascii, x, y, size, fgcolor, bgcolor, TFT_FONT_X * size + 1);
+}
 
-    if((ascii >= 32) && (ascii <= 127))
-    {
-        ;
-    }
-    else
-    {
-        ascii = '?'-32;
-    }
-    for (i =0; i < TFT_FONT_X; i++ )
-    {
-        uint8_t temp = font_map[ascii-0x20][i];
-        for(f=0; f < 8; f++)
-        {
-            if((temp >> f) & 0x01)
-            {
-                tft_fill_rectangle(x + i * size, y + f * size,
-                                   size, size, fgcolor);
-            }
-            else
-            {
-                tft_fill_rectangle(x + i * size, y + f * size,
-                                   size, size, bgcolor);
-            }
-        }
-    }
+/**
+ * @brief   Draw ASCII charactar at (x,y) clipped to its character cell
+ *          The cell is the advance width of tft_draw_string (6 * size), so
+ *          redrawing one cell leaves the next one untouched
+ * @param   ascii    ASCII Character. eg: 'A'
+ * @param   x        Starting x position
+ * @param   y        Starting y position
+ * @param   size     Size of the font
+ * @param   fgcolor  Foreground colour
+ * @param   bgcolor  Background colour
+ */
+void tft_draw_char_cell(uint8_t ascii, uint16_t x, uint16_t y,
+                        uint16_t size, uint16_t fgcolor, uint16_t bgcolor)
+{
+    draw_char(ascii, x, y, size, fgcolor, bgcolor,
+              max(TFT_FONT_SPACE * size, 1));
 }
 
 /**
@@ -1186,31 +2412,19 @@ uint8_t tft_draw_number(int long_num, uint16_t x, uint16_t y,
 void tft_draw_char_only(uint8_t ascii, uint16_t x, uint16_t y,
                         uint16_t size, uint16_t color)
 {
-    uint8_t col = 0;
-    uint8_t row = 0;
-    uint8_t bit = 0x01;
-    uint8_t oc = ascii - 0x20;
+    char string[2];
 
-    while (row < 8) 
-    {
-        while (col < 8) 
-        {
-                if (font_map[oc][col] & bit)
-                {
-                    /* tft_set_pixel(x + col, y + row, color); */
-                    tft_fill_rectangle(x + col * size, y + row * size,
-                                   size, size, color);
-                }
-                col++;
-        }
-        col = 0;
-        bit <<= 1;
-        row++;
-    }
+    string[0] = ascii;
+    string[1] = 0;
+
+    tft_draw_string_only(&string[0], x, y, size, color);
 }
 
 /**
 * @brief    Draw string at (x,y) without background colour
+*           Each glyph row of the whole string is drawn at once from the run
+*           tables (font_runs.h), runs touching across characters are merged
+*           and every run is one scaled span
 *
 * @param    string    String input. Eg: "abc"
 * @param    x         x coordinate
@@ -1221,16 +2435,369 @@ void tft_draw_char_only(uint8_t ascii, uint16_t x, uint16_t y,
 void tft_draw_string_only(char *string, uint16_t x, uint16_t y,
                           uint16_t size, uint16_t color)
 {
-    while(*string)
+    const char *c;
+    uint32_t cx;
+    uint32_t span_x0 = 0;
+    uint32_t span_x1 = 0;
+    uint32_t run_x0;
+    uint32_t run_x1;
+    uint32_t row_y;
+    bool     pending;
+    uint16_t run;
+    uint8_t  glyph;
+    uint8_t  row;
+
+    if (y > tft_info.max_y)
     {
-        tft_draw_char_only(*string, x, y, size, color);
-        *string++;
+        return;
+    }
 
-        if(x < tft_info.max_x)
+    tft_begin_transaction();
+
+    for (row = 0; row < TFT_FONT_Y; row++)
+    {
+        row_y = (uint32_t)y + row * size;
+
+        if (row_y > tft_info.max_y)
+        {
+            break;
+        }
+
+        pending = false;
+        cx = x;
+
+        for (c = string; *c; c++)
+        {
+            glyph = ((*c >= 32) && (*c <= 127)) ? (*c - 0x20) : ('?' - 0x20);
+
+            for (run = font_run_index[glyph];
+                 (run < font_run_index[glyph + 1]) && (font_runs[run][0] <= row);
+                 run++)
+            {
+                if (font_runs[run][0] != row)
+                {
+                    continue;
+                }
+
+                /* Cells are (size + 1) wide (see tft_fill_rectangle) */
+                run_x0 = cx + font_runs[run][1] * size;
+                run_x1 = cx + font_runs[run][2] * size + size;
+
+                if (pending && (run_x0 <= span_x1 + 1))
+                {
+                    span_x1 = max(span_x1, run_x1);
+                }
+                else
+                {
+                    if (pending)
+                    {
+                        write_text_span(span_x0, span_x1, row_y, size, color);
+                    }
+
+                    span_x0 = run_x0;
+                    span_x1 = run_x1;
+                    pending = true;
+                }
+            }
+
+            if(cx < tft_info.max_x)
+            {
+                cx += TFT_FONT_SPACE * size;
+            }
+        }
+
+        if (pending)
+        {
+            write_text_span(span_x0, span_x1, row_y, size, color);
+        }
+    }
+
+    tft_end_transaction();
+}
+
+/**
+ * @brief   Start terminal mode: text rows scroll up by hardware as lines are
+ *          appended, so a new line only writes its own row
+ *          Portrait orientation (ORIENT_V) only, since the controller
+ *          scrolls along the 320 GRAM rows. Other drawing is not scrolled
+ *          with the terminal, the fixed areas can be used for static content
+ * @param   top     Top fixed area (rows)
+ * @param   bottom  Minimum bottom fixed area (rows), the part of the scroll
+ *                  area that does not fit a whole text row is added to it
+ * @param   size    Font size
+ * @param   fgcolor Text colour (16-bit)
+ * @param   bgcolor Background colour (16-bit)
+ * @return  True if started
+ */
+bool tft_terminal_start(uint16_t top, uint16_t bottom,
+                        uint16_t size, uint16_t fgcolor, uint16_t bgcolor)
+{
+    terminal_info_t *term = &terminal_info;
+
+    if ((tft_info.orientation != ORIENT_V) ||
+        scroll_info.active ||
+        (size == 0) ||
+        ((uint32_t)top + bottom >= TFT_HEIGHT))
+    {
+        return false;
+    }
+
+    /* Glyphs are (8 * size + 1) high */
+    term->line_height = TFT_FONT_Y * size + 1;
+    term->rows = (TFT_HEIGHT - top - bottom) / term->line_height;
+
+    if (term->rows == 0)
+    {
+        return false;
+    }
+
+    term->top = top;
+    term->columns = (tft_info.max_x + 1) / (TFT_FONT_SPACE * size);
+    term->size = size;
+    term->fgcolor = fgcolor;
+    term->bgcolor = bgcolor;
+    term->slot = 0;
+    term->column = 0;
+    term->lines = 0;
+    term->newline = true;
+    term->active = true;
+
+    set_scroll_area(top, term->rows * term->line_height);
+    set_scroll_start(top);
+
+    tft_fill_area(0, top, tft_info.max_x,
+                  top + term->rows * term->line_height - 1, bgcolor);
+
+    return true;
+}
+
+/**
+ * @brief   Append text to the terminal
+ *          '\n' ends a row (the next row is started by the next character),
+ *          rows longer than the screen are wrapped
+ * @param   text    Text
+ */
+void tft_terminal_write(const char *text)
+{
+    terminal_info_t *term = &terminal_info;
+
+    ASSERT(text != NULL);
+
+    if (!term->active)
+    {
+        return;
+    }
+
+    for (; *text; text++)
+    {
+        if (*text == '\n')
         {
-            x += TFT_FONT_SPACE * size;
+            term->newline = true;
+            continue;
         }
+
+        if (term->newline || (term->column >= term->columns))
+        {
+            terminal_new_line();
+            term->newline = false;
+        }
+
+        tft_draw_char(*text,
+                      term->column * TFT_FONT_SPACE * term->size,
+                      term->top + term->slot * term->line_height,
+                      term->size, term->fgcolor, term->bgcolor);
+
+        term->column++;
+    }
+}
+
+/**
+ * @brief   Leave terminal mode and clear the terminal rows
+ */
+void tft_terminal_stop(void)
+{
+    terminal_info_t *term = &terminal_info;
+
+    if (!term->active)
+    {
+        return;
+    }
+
+    term->active = false;
+
+    set_scroll_start(0);
+    set_scroll_area(0, TFT_HEIGHT);
+
+    tft_begin_transaction();
+    write_command(NORON);                   /* Leave scrolling mode */
+    tft_end_transaction();
+
+    tft_fill_area(0, term->top, tft_info.max_x,
+                  term->top + term->rows * term->line_height - 1,
+                  term->bgcolor);
+}
+
+/**
+ * @brief   Check whether terminal mode is on
+ * @return  True if on
+ */
+bool tft_terminal_active(void)
+{
+    return terminal_info.active;
+}
+
+/**
+ * @brief   Start hardware scrolling of a screen band
+ *          The controller scrolls along the 320 GRAM rows: the band is
+ *          lines start to start + length - 1 of the 320 pixel screen axis
+ *          (y in portrait, x in landscape) and spans the whole other axis.
+ *          Each tft_scroll_step moves the band content one line towards
+ *          start, the line returned by tft_scroll_line comes in at the end
+ * @param   start   First line of the band
+ * @param   length  Number of lines
+ * @return  True if started (false if scrolling is in use by the terminal
+ *          or the band does not fit)
+ */
+bool tft_scroll_begin(uint16_t start, uint16_t length)
+{
+    if (terminal_info.active ||
+        (length == 0) ||
+        ((uint32_t)start + length > TFT_HEIGHT))
+    {
+        return false;
+    }
+
+    /* Screen lines follow GRAM rows unless the row order is reversed */
+    scroll_info.mirrored = ((tft_info.orientation & MADCTL_MY) != 0);
+    scroll_info.start = start;
+    scroll_info.length = length;
+    scroll_info.offset = 0;
+
+    if (scroll_info.mirrored)
+    {
+        scroll_info.top = TFT_HEIGHT - start - length;
+    }
+    else
+    {
+        scroll_info.top = start;
     }
+
+    scroll_info.active = true;
+
+    set_scroll_area(scroll_info.top, length);
+    set_scroll_start(scroll_info.top);
+
+    return true;
+}
+
+/**
+ * @brief   Screen line holding the oldest band content
+ *          Draw the new line there, then call tft_scroll_step to show it at
+ *          the end of the band
+ * @return  Screen line (x in landscape, y in portrait)
+ */
+uint16_t tft_scroll_line(void)
+{
+    uint16_t offset;
+
+    ASSERT(scroll_info.active);
+
+    if (scroll_info.mirrored)
+    {
+        offset = (scroll_info.offset + scroll_info.length - 1) %
+                 scroll_info.length;
+
+        return scroll_info.start + scroll_info.length - 1 - offset;
+    }
+
+    return scroll_info.start + scroll_info.offset;
+}
+
+/**
+ * @brief   Scroll the band content one line towards its start
+ */
+void tft_scroll_step(void)
+{
+    ASSERT(scroll_info.active);
+
+    if (scroll_info.mirrored)
+    {
+        scroll_info.offset = (scroll_info.offset + scroll_info.length - 1) %
+                             scroll_info.length;
+    }
+    else
+    {
+        scroll_info.offset = (scroll_info.offset + 1) % scroll_info.length;
+    }
+
+    set_scroll_start(scroll_info.top + scroll_info.offset);
+}
+
+/**
+ * @brief   Stop hardware scrolling
+ *          The band shows GRAM unscrolled again, its content is to be redrawn
+ */
+void tft_scroll_end(void)
+{
+    if (!scroll_info.active)
+    {
+        return;
+    }
+
+    scroll_info.active = false;
+
+    set_scroll_start(0);
+    set_scroll_area(0, TFT_HEIGHT);
+
+    tft_begin_transaction();
+    write_command(NORON);                   /* Leave scrolling mode */
+    tft_end_transaction();
+}
+
+/**
+ * @brief   Screen width in the current orientation
+ * @return  Width (pixels)
+ */
+uint16_t tft_get_width(void)
+{
+    return tft_info.max_x + 1;
+}
+
+/**
+ * @brief   Screen height in the current orientation
+ * @return  Height (pixels)
+ */
+uint16_t tft_get_height(void)
+{
+    return tft_info.max_y + 1;
+}
+
+/**
+ * @brief   Number of command bytes saved by the address window cache
+ *          (skipped CASET/PASET and RAMWR continuations)
+ * @return  Saved bytes since initialisation
+ */
+uint32_t tft_get_saved_bytes(void)
+{
+    return tft_info.saved_bytes;
+}
+
+/**
+ * @brief   Number of glyphs drawn from the glyph cache
+ * @return  Hits since initialisation
+ */
+uint32_t tft_get_glyph_cache_hits(void)
+{
+    return glyph_cache.hits;
+}
+
+/**
+ * @brief   Number of glyphs expanded into the glyph cache
+ * @return  Misses since initialisation
+ */
+uint32_t tft_get_glyph_cache_misses(void)
+{
+    return glyph_cache.misses;
 }
 
 /**
@@ -1280,6 +2847,16 @@ void tft_running_animation(void)
  */
 void tft_init(void)
 {
+    invalidate_window();
+    tft_info.saved_bytes = 0;
+
+    glyph_cache_clear();
+    glyph_cache.hits = 0;
+    glyph_cache.misses = 0;
+
+    terminal_info.active = false;
+    scroll_info.active = false;
+
 #if NON_BLOCKING
     tft_services->register_done_callback = tft_register_done_callback;
 
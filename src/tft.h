@@ -27,6 +27,7 @@
 /* Local includes */
 #include "lib.h"
 #include "spi.h"
+#include "raster.h"
 
 /*-----------------------------------------------------------------------------
  *  Constants
@@ -50,10 +51,32 @@
 #define ORIENT_H        0xe8
 #define ORIENT_H_I      0x28
 
+/* Flash asset RLE token: run of (token & ~TFT_ASSET_RUN) pixels of the
+ * colour word that follows, otherwise a literal of token pixel words */
+#define TFT_ASSET_RUN   0x8000
+
 /*-----------------------------------------------------------------------------
  *  Types
  *-----------------------------------------------------------------------------*/
 
+/* Flash asset pixel format */
+typedef enum
+{
+    TFT_ASSET_RAW = 0,
+    TFT_ASSET_RLE
+} tft_asset_format_t;
+
+/* Flash asset (see imgconv.py) */
+typedef struct
+{
+    uint16_t           width;
+    uint16_t           height;
+    tft_asset_format_t format;
+
+    /* RGB565 pixels row by row, or RLE tokens (never crossing a row) */
+    const uint16_t     *data;
+} tft_asset_t;
+
 #if NON_BLOCKING
 typedef enum
 {
@@ -75,6 +98,10 @@ typedef void (*tft_done_cb_t)(void);
  *  Services
  *-----------------------------------------------------------------------------*/
 
+void tft_begin_transaction(void);
+void tft_write_command(uint8_t cmd);
+void tft_write_data(const uint8_t *data, uint32_t size);
+void tft_end_transaction(void);
 void tft_send_command(uint8_t cmd);
 void tft_send_data(uint8_t data);
 void tft_send_raw(uint8_t    cmd,
@@ -101,12 +128,28 @@ void tft_draw_line(uint16_t x0, uint16_t y0,
                    uint16_t x1, uint16_t y1,
                    uint16_t color);
 void tft_send_data_only(uint8_t byte);
+void tft_send_pixels(const uint16_t *pixels, uint32_t count);
+void tft_send_color(uint16_t color, uint32_t count);
+void tft_write_pixels(uint16_t x0, uint16_t y0,
+                      uint16_t x1, uint16_t y1,
+                      const uint16_t *pixels, uint32_t count);
+bool tft_blit_asset(uint8_t id, uint16_t x, uint16_t y);
+void tft_draw_mask_row(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+                       uint16_t row, const uint8_t *bits,
+                       uint16_t fgcolor, uint16_t bgcolor, bool transparent);
 void tft_fill_rectangle(uint16_t x, uint16_t y,
                         uint16_t length, uint16_t width,
                         uint16_t color);
 void tft_fill_circle(uint16_t xc, uint16_t yc,
                      int16_t r,
                      uint16_t color);
+void tft_fill_triangle(uint16_t x0, uint16_t y0,
+                       uint16_t x1, uint16_t y1,
+                       uint16_t x2, uint16_t y2,
+                       uint16_t color);
+void tft_fill_polygon(const raster_point_t *points,
+                      uint8_t count,
+                      uint16_t color);
 void tft_draw_rectangle(uint16_t x, uint16_t y,
                         uint16_t length, uint16_t width,
                         uint16_t color);
@@ -119,6 +162,8 @@ void tft_draw_circle(uint16_t xc, uint16_t yc,
                      uint16_t color);
 void tft_draw_char(uint8_t ascii, uint16_t x, uint16_t y,
                    uint16_t size, uint16_t fgcolor, uint16_t bgcolor);
+void tft_draw_char_cell(uint8_t ascii, uint16_t x, uint16_t y,
+                        uint16_t size, uint16_t fgcolor, uint16_t bgcolor);
 void tft_draw_string(char *string, uint16_t x, uint16_t y,
                      uint16_t size, uint16_t fgcolor, uint16_t bgcolor);
 uint8_t tft_draw_number(int long_num, uint16_t x, uint16_t y,
@@ -127,6 +172,20 @@ void tft_draw_char_only(uint8_t ascii, uint16_t x, uint16_t y,
                         uint16_t size, uint16_t color);
 void tft_draw_string_only(char *string, uint16_t x, uint16_t y,
                           uint16_t size, uint16_t color);
+bool tft_terminal_start(uint16_t top, uint16_t bottom,
+                        uint16_t size, uint16_t fgcolor, uint16_t bgcolor);
+void tft_terminal_write(const char *text);
+void tft_terminal_stop(void);
+bool tft_terminal_active(void);
+bool tft_scroll_begin(uint16_t start, uint16_t length);
+uint16_t tft_scroll_line(void);
+void tft_scroll_step(void);
+void tft_scroll_end(void);
+uint16_t tft_get_width(void);
+uint16_t tft_get_height(void);
+uint32_t tft_get_saved_bytes(void);
+uint32_t tft_get_glyph_cache_hits(void);
+uint32_t tft_get_glyph_cache_misses(void);
 void tft_test(void);
 void tft_running_animation(void);
 
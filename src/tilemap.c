@@ -0,0 +1,394 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  tilemap.c
+ *
+ *    Description:  Tile map implementation file
+ *                  The host uploads a tile set once into RAM: square tiles
+ *                  of 8x8 or 16x16 pixels, RGB565 (MSB first) or 4-bpp
+ *                  indexed (high nibble first) with a 16 colour palette.
+ *                  A map of tile indices then covers a screen rectangle.
+ *                  Each map row is streamed row-major into one window, a
+ *                  changed cell is drawn into a window of its own.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 11:48:09 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Local Includes */
+#include "tilemap.h"
+#include "tft.h"
+#include "setting.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* Palette of indexed tiles */
+#define TILEMAP_PALETTE_SIZE    (16U)
+
+/* Pixel buffer size (multiple of every tile width), two buffers are used
+ * in ping-pong */
+#define TILEMAP_CHUNK_SIZE      (64U)
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    /* Tile width and height (0 until a tile set is loaded) */
+    uint8_t  size;
+    uint8_t  bpp;
+    uint16_t tile_bytes;
+
+    /* Number of tiles the tile set memory holds */
+    uint16_t capacity;
+
+    uint16_t palette[TILEMAP_PALETTE_SIZE];
+
+    /* Upload position: palette bytes still expected, next tile byte */
+    uint8_t  palette_left;
+    uint32_t offset;
+
+    /* Map is placed */
+    bool     placed;
+
+    /* Screen position of the top left cell */
+    uint16_t x;
+    uint16_t y;
+
+    uint8_t  cols;
+    uint8_t  rows;
+
+    /* Cells received by tilemap_map */
+    uint16_t received;
+
+    /* Pixels waiting in the current chunk */
+    uint8_t  chunk_size;
+    uint8_t  chunk_index;
+} tilemap_info_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static tilemap_info_t tilemap_info;
+
+/* Tile set, tiles stored as received */
+static uint8_t tileset[TILESET_SIZE];
+
+/* Tile index of every map cell, row-major */
+static uint8_t cells[TILEMAP_CELLS];
+
+static uint16_t chunk[2][TILEMAP_CHUNK_SIZE];
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Colour of one tile pixel
+ *          A tile beyond the tile set memory is black
+ * @param   tile    Tile index
+ * @param   col     Pixel column within the tile
+ * @param   line    Pixel row within the tile
+ * @return  Colour (16-bit)
+ */
+static uint16_t tile_pixel(uint8_t tile, uint8_t col, uint8_t line)
+{
+    tilemap_info_t *info = &tilemap_info;
+    const uint8_t *p;
+
+    if (tile >= info->capacity)
+    {
+        return 0x0000;
+    }
+
+    p = &tileset[tile * info->tile_bytes +
+                 (line * info->size + col) * info->bpp / 8];
+
+    if (info->bpp == 16)
+    {
+        return convert_to_word(p[0], p[1]);
+    }
+
+    return info->palette[(col & 1) ? (p[0] & 0x0f) : (p[0] >> 4)];
+}
+
+/**
+ * @brief   Expand one pixel row of a tile
+ * @param   tile    Tile index
+ * @param   line    Pixel row within the tile
+ * @param   out     Output: tile width pixels
+ */
+static void tile_line(uint8_t tile, uint8_t line, uint16_t *out)
+{
+    uint8_t i;
+
+    for (i = 0; i < tilemap_info.size; i++)
+    {
+        out[i] = tile_pixel(tile, i, line);
+    }
+}
+
+/**
+ * @brief   Hand the pixels gathered so far to uDMA and fill the other chunk
+ */
+static void flush(void)
+{
+    if (tilemap_info.chunk_size > 0)
+    {
+        tft_send_pixels(&chunk[tilemap_info.chunk_index][0],
+                        tilemap_info.chunk_size);
+
+        tilemap_info.chunk_index ^= 1;
+        tilemap_info.chunk_size = 0;
+    }
+}
+
+/**
+ * @brief   Draw count cells of a map row in one window
+ * @param   col     First column
+ * @param   row     Map row
+ * @param   count   Number of cells
+ */
+static void draw_cells(uint8_t col, uint8_t row, uint8_t count)
+{
+    tilemap_info_t *info = &tilemap_info;
+    const uint8_t *tiles = &cells[row * info->cols + col];
+    uint16_t x0 = info->x + col * info->size;
+    uint16_t y0 = info->y + row * info->size;
+    uint8_t line;
+    uint8_t i;
+
+    tft_start_image_transfer(x0, y0, x0 + count * info->size - 1,
+                             y0 + info->size - 1);
+
+    for (line = 0; line < info->size; line++)
+    {
+        for (i = 0; i < count; i++)
+        {
+            if (info->chunk_size + info->size > TILEMAP_CHUNK_SIZE)
+            {
+                flush();
+            }
+
+            tile_line(tiles[i], line,
+                      &chunk[info->chunk_index][info->chunk_size]);
+
+            info->chunk_size += info->size;
+        }
+    }
+
+    flush();
+
+    tft_done_transfer();
+}
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Start loading tiles into the tile set
+ *          Tiles already loaded stay if the format is unchanged. Indexed
+ *          tiles are preceded by the 16 colour palette (MSB first)
+ * @param   size    Tile width and height (8 or 16)
+ * @param   bpp     Bits per pixel (16 for RGB565 or 4 for indexed)
+ * @param   first   Index of the first tile loaded
+ * @return  False if the format is not supported
+ */
+bool tilemap_load_begin(uint8_t size, uint8_t bpp, uint8_t first)
+{
+    tilemap_info_t *info = &tilemap_info;
+
+    if (((size != 8) && (size != 16)) || ((bpp != 16) && (bpp != 4)))
+    {
+        return false;
+    }
+
+    /* The map no longer matches tiles of another size */
+    if (size != info->size)
+    {
+        info->placed = false;
+    }
+
+    info->size = size;
+    info->bpp = bpp;
+    info->tile_bytes = size * size * bpp / 8;
+    info->capacity = min(TILESET_SIZE / info->tile_bytes, 256);
+    info->palette_left = (bpp == 4) ? (2 * TILEMAP_PALETTE_SIZE) : 0;
+    info->offset = (uint32_t)first * info->tile_bytes;
+
+    return true;
+}
+
+/**
+ * @brief   Load the next byte of the palette or of the tiles
+ *          Tiles beyond the tile set memory are dropped
+ * @param   byte    Received byte
+ */
+void tilemap_load(uint8_t byte)
+{
+    tilemap_info_t *info = &tilemap_info;
+    uint8_t index;
+
+    if (info->palette_left > 0)
+    {
+        index = TILEMAP_PALETTE_SIZE - (info->palette_left + 1) / 2;
+
+        if (info->palette_left & 1)
+        {
+            info->palette[index] |= byte;
+        }
+        else
+        {
+            info->palette[index] = (uint16_t)byte << 8;
+        }
+
+        info->palette_left--;
+    }
+    else if (info->offset < (uint32_t)info->capacity * info->tile_bytes)
+    {
+        tileset[info->offset++] = byte;
+    }
+}
+
+/**
+ * @brief   Place the map, its cells follow with tilemap_map
+ * @param   x       x coordinate of the top left cell
+ * @param   y       y coordinate of the top left cell
+ * @param   cols    Number of columns
+ * @param   rows    Number of rows
+ * @return  False if there is no tile set, the map has more than
+ *          TILEMAP_CELLS cells or does not fit the screen
+ */
+bool tilemap_place(uint16_t x, uint16_t y, uint8_t cols, uint8_t rows)
+{
+    tilemap_info_t *info = &tilemap_info;
+
+    info->placed = (info->size > 0) &&
+                   (cols > 0) && (rows > 0) &&
+                   ((uint16_t)cols * rows <= TILEMAP_CELLS) &&
+                   ((uint32_t)x + cols * info->size <= tft_get_width()) &&
+                   ((uint32_t)y + rows * info->size <= tft_get_height());
+
+    info->x = x;
+    info->y = y;
+    info->cols = cols;
+    info->rows = rows;
+    info->received = 0;
+
+    return info->placed;
+}
+
+/**
+ * @brief   Set the next cell of the map (row-major)
+ *          Each map row is drawn in one window once complete
+ * @param   tile    Tile index
+ */
+void tilemap_map(uint8_t tile)
+{
+    tilemap_info_t *info = &tilemap_info;
+
+    if (!info->placed || (info->received >= (uint16_t)info->cols * info->rows))
+    {
+        return;
+    }
+
+    cells[info->received++] = tile;
+
+    if ((info->received % info->cols) == 0)
+    {
+        draw_cells(0, info->received / info->cols - 1, info->cols);
+    }
+}
+
+/**
+ * @brief   Change one map cell
+ *          The cell is drawn only if its tile changed
+ * @param   col     Column
+ * @param   row     Row
+ * @param   tile    Tile index
+ */
+void tilemap_set_cell(uint8_t col, uint8_t row, uint8_t tile)
+{
+    tilemap_info_t *info = &tilemap_info;
+    uint16_t cell = (uint16_t)row * info->cols + col;
+
+    if (!info->placed || (col >= info->cols) || (row >= info->rows) ||
+        (cells[cell] == tile))
+    {
+        return;
+    }
+
+    cells[cell] = tile;
+
+    draw_cells(col, row, 1);
+}
+
+/**
+ * @brief   Read the map pixels of a screen row segment
+ *          (background of sprites, see sprite.c)
+ * @param   x       x coordinate of the first pixel
+ * @param   y       y coordinate
+ * @param   count   Number of pixels
+ * @param   color   Colour of pixels outside the map
+ * @param   out     Output: count pixels
+ */
+void tilemap_read(uint16_t x, uint16_t y, uint16_t count,
+                  uint16_t color, uint16_t *out)
+{
+    tilemap_info_t *info = &tilemap_info;
+    uint16_t map_width = info->cols * info->size;
+    uint16_t map_height = info->rows * info->size;
+    uint16_t row, col;
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        out[i] = color;
+    }
+
+    if (!info->placed || (y < info->y) || (y - info->y >= map_height))
+    {
+        return;
+    }
+
+    row = (y - info->y) / info->size;
+
+    for (i = 0; i < count; i++)
+    {
+        if ((x + i >= info->x) && (x + i - info->x < map_width))
+        {
+            col = (x + i - info->x) / info->size;
+
+            out[i] = tile_pixel(cells[row * info->cols + col],
+                                (x + i - info->x) % info->size,
+                                (y - info->y) % info->size);
+        }
+    }
+}
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Tile map initialisation
+ */
+void tilemap_init(void)
+{
+    memset(&tilemap_info, 0, sizeof(tilemap_info));
+}
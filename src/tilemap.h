@@ -0,0 +1,49 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  tilemap.h
+ *
+ *    Description:  Tile map header file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 11:48:09 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+
+/* Third party libraries include */
+
+/* Local includes */
+#include "lib.h"
+
+/*-----------------------------------------------------------------------------
+ *  Services
+ *-----------------------------------------------------------------------------*/
+
+bool tilemap_load_begin(uint8_t size, uint8_t bpp, uint8_t first);
+void tilemap_load(uint8_t byte);
+bool tilemap_place(uint16_t x, uint16_t y, uint8_t cols, uint8_t rows);
+void tilemap_map(uint8_t tile);
+void tilemap_set_cell(uint8_t col, uint8_t row, uint8_t tile);
+void tilemap_read(uint16_t x, uint16_t y, uint16_t count,
+                  uint16_t color, uint16_t *out);
+
+/*-----------------------------------------------------------------------------
+ *  Initialisation
+ *-----------------------------------------------------------------------------*/
+
+void tilemap_init(void);
+
+#endif
@@ -0,0 +1,391 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  dma_test.c
+ *
+ *    Description:  Host test of the uDMA chunking engine
+ *                  dma.c is attached to a fake dma_hal_t modelling one
+ *                  channel in ping-pong mode: the active control structure
+ *                  runs to completion, the channel switches to the other
+ *                  one and stops if that one is not loaded. The engine is
+ *                  serviced after every completion, as the SSI interrupt
+ *                  does.
+ *
+ *                  Each case checks the items received, the order the
+ *                  control structures are loaded in (primary, alternate,
+ *                  primary...) with their source offsets, that a structure
+ *                  is only reloaded once it has completed, and that the
+ *                  channel never stops with items left.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 09:40:18 AM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Standard includes */
+#include <stdio.h>
+
+/* Local Includes */
+#include "dma.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* Largest job of the cases (items) */
+#define MAX_ITEMS           (2 * DMA_MAX_TRANSFER + 1)
+
+/* Control structure loads of the largest job */
+#define MAX_LOADS           (8U)
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+/* Control structure of the fake channel */
+typedef struct
+{
+    const uint8_t *src;
+    uint32_t       count;
+
+    /* Mode is STOP: completed, or never loaded */
+    bool           stopped;
+} fake_control_t;
+
+/* One transfer_set call */
+typedef struct
+{
+    dma_select_t select;
+
+    /* Source offset from the start of the job (items) */
+    uint32_t     offset;
+    uint32_t     count;
+} fake_load_t;
+
+/* Fake uDMA channel */
+typedef struct
+{
+    fake_control_t control[DMA_SELECT_COUNT];
+
+    uint8_t        item_size;
+    bool           src_increment;
+
+    bool           enabled;
+
+    /* Control structure the channel runs */
+    dma_select_t   active;
+
+    /* Start of the job, for the load offsets */
+    const uint8_t  *base;
+
+    fake_load_t    load[MAX_LOADS];
+    uint8_t        loads;
+
+    /* Items written to the SSI data register */
+    uint16_t       sink[MAX_ITEMS];
+    uint32_t       received;
+
+    uint8_t        disables;
+} fake_channel_t;
+
+/* Test case */
+typedef struct
+{
+    uint32_t count;
+    uint8_t  item_size;
+    bool     src_increment;
+} dma_case_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static fake_channel_t channel;
+
+/* Sources: a pixel buffer, its bytes, and a solid colour */
+static uint16_t buffer[MAX_ITEMS];
+static uint8_t  buffer8[MAX_ITEMS];
+static uint16_t solid = 0xA55A;
+static uint8_t  solid8 = 0x5A;
+
+static const dma_case_t cases[] =
+{
+    /* count                     size  increment */
+    { 1,                         2,    true  },
+    { DMA_MAX_TRANSFER - 1,      2,    true  },
+    { DMA_MAX_TRANSFER,          2,    true  },
+    { DMA_MAX_TRANSFER + 1,      2,    true  },
+    { 2 * DMA_MAX_TRANSFER + 1,  2,    true  },
+    { 1,                         2,    false },
+    { DMA_MAX_TRANSFER - 1,      2,    false },
+    { DMA_MAX_TRANSFER,          2,    false },
+    { DMA_MAX_TRANSFER + 1,      2,    false },
+    { 2 * DMA_MAX_TRANSFER + 1,  2,    false },
+    { 1,                         1,    true  },
+    { DMA_MAX_TRANSFER + 1,      1,    true  },
+    { 2 * DMA_MAX_TRANSFER + 1,  1,    true  },
+    { DMA_MAX_TRANSFER + 1,      1,    false },
+};
+
+/*-----------------------------------------------------------------------------
+ *  Fake dma_hal_t
+ *-----------------------------------------------------------------------------*/
+
+static void fake_init(void)
+{
+    memset(&channel, 0, sizeof(channel));
+
+    channel.control[DMA_PRIMARY].stopped = true;
+    channel.control[DMA_ALTERNATE].stopped = true;
+}
+
+static void fake_setup(uint8_t item_size, bool src_increment)
+{
+    /* Channel control words only change while the channel is off */
+    ASSERT(!channel.enabled);
+
+    channel.item_size = item_size;
+    channel.src_increment = src_increment;
+}
+
+static void fake_transfer_set(dma_select_t select,
+                              const void   *src,
+                              uint32_t     count)
+{
+    fake_control_t *control = &channel.control[select];
+    fake_load_t *load = &channel.load[channel.loads++];
+
+    ASSERT(channel.loads <= MAX_LOADS);
+    ASSERT((count > 0) && (count <= DMA_MAX_TRANSFER));
+
+    /* A structure still waiting or running must not be overwritten */
+    ASSERT(control->stopped);
+
+    control->src = src;
+    control->count = count;
+    control->stopped = false;
+
+    load->select = select;
+    load->offset = ((const uint8_t *)src - channel.base) / channel.item_size;
+    load->count = count;
+}
+
+static bool fake_is_done(dma_select_t select)
+{
+    return channel.control[select].stopped;
+}
+
+static void fake_enable(void)
+{
+    ASSERT(!channel.enabled);
+
+    channel.enabled = true;
+    channel.active = DMA_PRIMARY;
+}
+
+static void fake_disable(void)
+{
+    channel.enabled = false;
+    channel.disables++;
+}
+
+static const dma_hal_t fake_hal =
+{
+    fake_init,
+    fake_setup,
+    fake_transfer_set,
+    fake_is_done,
+    fake_enable,
+    fake_disable
+};
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Run the active control structure to completion
+ *          The channel then switches to the other structure, and stops if
+ *          that one is not loaded
+ */
+static void fake_complete(void)
+{
+    fake_control_t *control = &channel.control[channel.active];
+    const uint8_t *item;
+    uint32_t i;
+
+    ASSERT(channel.enabled && !control->stopped);
+
+    for (i = 0; i < control->count; i++)
+    {
+        item = control->src + (channel.src_increment ? i * channel.item_size : 0);
+
+        ASSERT(channel.received < MAX_ITEMS);
+
+        channel.sink[channel.received++] = (channel.item_size == 2) ?
+                                           *(const uint16_t *)item : *item;
+    }
+
+    control->stopped = true;
+
+    channel.active = (channel.active == DMA_PRIMARY) ? DMA_ALTERNATE :
+                                                       DMA_PRIMARY;
+
+    if (channel.control[channel.active].stopped)
+    {
+        channel.enabled = false;
+    }
+}
+
+/**
+ * @brief   Run one case
+ * @param   test    Case
+ * @return  True if passed
+ */
+static bool run(const dma_case_t *test)
+{
+    const void *src;
+    uint16_t expected;
+    uint32_t remaining = test->count;
+    uint32_t offset = 0;
+    uint32_t i;
+    uint8_t  interrupts = 0;
+    uint8_t  loads = 0;
+    bool     stalled = false;
+    bool     order = true;
+    bool     items = true;
+    bool     pass;
+
+    if (test->item_size == 2)
+    {
+        src = test->src_increment ? (const void *)buffer : (const void *)&solid;
+    }
+    else
+    {
+        src = test->src_increment ? (const void *)buffer8 : (const void *)&solid8;
+    }
+
+    /* A stalled case leaves the engine busy */
+    dma_init();
+    dma_open(&fake_hal);
+    channel.base = src;
+
+    dma_start(src, test->count, test->item_size, test->src_increment);
+
+    /* One interrupt per completed control structure */
+    while (dma_busy())
+    {
+        if (!channel.enabled)
+        {
+            stalled = true;
+            break;
+        }
+
+        fake_complete();
+        interrupts++;
+
+        dma_service();
+    }
+
+    /* Primary and alternate take turns, each with the next chunk */
+    while (remaining > 0)
+    {
+        i = min(remaining, DMA_MAX_TRANSFER);
+
+        if ((loads >= channel.loads) ||
+            (channel.load[loads].select != ((loads & 1) ? DMA_ALTERNATE :
+                                                          DMA_PRIMARY)) ||
+            (channel.load[loads].offset != (test->src_increment ? offset : 0)) ||
+            (channel.load[loads].count != i))
+        {
+            order = false;
+        }
+
+        loads++;
+        offset += i;
+        remaining -= i;
+    }
+
+    order = order && (loads == channel.loads);
+
+    for (i = 0; i < test->count; i++)
+    {
+        if (test->item_size == 2)
+        {
+            expected = test->src_increment ? buffer[i] : solid;
+        }
+        else
+        {
+            expected = test->src_increment ? buffer8[i] : solid8;
+        }
+
+        if ((i >= channel.received) || (channel.sink[i] != expected))
+        {
+            items = false;
+            break;
+        }
+    }
+
+    items = items && (channel.received == test->count);
+
+    pass = !stalled && order && items && !channel.enabled &&
+           (channel.disables == 1) && (interrupts == channel.loads);
+
+    printf("%4u x %u-byte %-6s  loads %u  interrupts %u  order %s  "
+           "items %s  %s\n",
+           test->count, test->item_size,
+           test->src_increment ? "buffer" : "solid",
+           channel.loads, interrupts, order ? "ok  " : "FAIL",
+           items ? "ok  " : "FAIL",
+           stalled ? "STALLED" : (pass ? "pass" : "FAIL"));
+
+    return pass;
+}
+
+/*-----------------------------------------------------------------------------
+ *  Main
+ *-----------------------------------------------------------------------------*/
+
+int main(void)
+{
+    uint8_t failed = 0;
+    uint32_t i;
+
+    for (i = 0; i < MAX_ITEMS; i++)
+    {
+        buffer[i] = (uint16_t)(i * 0x9E37 + 1);
+        buffer8[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    /* Chunk sizes around the limit */
+    if ((dma_chunk_size(0) != 0) ||
+        (dma_chunk_size(1) != 1) ||
+        (dma_chunk_size(DMA_MAX_TRANSFER) != DMA_MAX_TRANSFER) ||
+        (dma_chunk_size(DMA_MAX_TRANSFER + 1) != DMA_MAX_TRANSFER))
+    {
+        printf("dma_chunk_size FAIL\n");
+        failed++;
+    }
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        if (!run(&cases[i]))
+        {
+            failed++;
+        }
+    }
+
+    printf("%u of %u cases failed\n", failed,
+           (unsigned)(sizeof(cases) / sizeof(cases[0]) + 1));
+
+    return (failed == 0) ? 0 : 1;
+}
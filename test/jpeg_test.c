@@ -0,0 +1,502 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  jpeg_test.c
+ *
+ *    Description:  Host conformance test of the JPEG decoder
+ *                  jpeg.c is built against a screen model standing in for
+ *                  tft_write_pixels. Test images are encoded with libjpeg,
+ *                  fed to the decoder one byte at a time, and the screen is
+ *                  compared with the libjpeg decode (islow IDCT, no fancy
+ *                  upsampling) reduced to RGB565. Every decoded screen is
+ *                  written as a PPM file.
+ *
+ *                  jpeg_test               run every case
+ *                  jpeg_test in.jpg out.ppm [x y]
+ *                                          decode one file to a PPM file
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 11:31:52 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Standard includes */
+#include <stdio.h>
+#include <math.h>
+
+/* Third party libraries include */
+#include <jpeglib.h>
+
+/* Local Includes */
+#include "jpeg.h"
+#include "tft.h"
+#include "scratch.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* Screen size (landscape) */
+#define SCREEN_WIDTH        (320U)
+#define SCREEN_HEIGHT       (240U)
+
+/* Largest channel difference to libjpeg, on the 8-bit scale after both are
+ * reduced to RGB565 (colour conversion rounding may flip the last bit) */
+#define MAX_DIFF            (8)
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+/* Test image */
+typedef struct
+{
+    const char *name;
+
+    uint16_t    width;
+    uint16_t    height;
+
+    /* Luma sampling factors, 0 for greyscale */
+    uint8_t     h;
+    uint8_t     v;
+
+    /* MCUs between restart markers (0 for none) */
+    uint16_t    restart;
+
+    uint8_t     quality;
+    bool        progressive;
+
+    /* Huffman tables fitted to the image: a run of zero bits read past the
+     * input may then decode as a long zero run */
+    bool        optimize;
+
+    /* High-frequency content instead of gradients */
+    bool        busy;
+
+    /* Bytes of the file fed (0 for all) */
+    uint32_t    truncate;
+
+    /* Screen position of the top left corner */
+    uint16_t    x;
+    uint16_t    y;
+} jpeg_case_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static const jpeg_case_t cases[] =
+{
+    /* name          w    h   h  v  rst  q   prog   opt    busy  trunc  x    y */
+    { "grey",        64,  48, 0, 0,  0, 75, false, false, false,    0,  0,   0 },
+    { "444_odd",     33,  17, 1, 1,  0, 90, false, false, false,    0,  5,   3 },
+    { "422_rst",     80,  40, 2, 1,  3, 75, false, false, false,    0,  0,   0 },
+    { "420",        100,  75, 2, 2,  0, 90, false, false, false,    0, 10,  20 },
+    { "420_rst",     72,  56, 2, 2,  1, 50, false, false, false,    0,  0,   0 },
+    { "screen",     320, 240, 2, 2,  0, 75, false, false, false,    0,  0,   0 },
+    { "clipped",     96,  80, 2, 2,  4, 75, false, false, false,    0, 260, 190 },
+    { "optimized",  120,  90, 2, 2,  0, 85, false, true,  true,     0,  0,   0 },
+    { "optimized_422",96, 96, 2, 1,  0, 85, false, true,  true,     0,  0,   0 },
+    { "truncated",  320, 240, 2, 2,  0, 75, false, false, false, 4000,  0,   0 },
+    { "progressive", 64,  64, 2, 2,  0, 75, true,  false, false,    0,  0,   0 },
+};
+
+/* Screen model */
+static uint16_t screen[SCREEN_HEIGHT][SCREEN_WIDTH];
+
+/* Window and write cursor of the screen model */
+static uint16_t window_x0, window_y0, window_x1, window_y1;
+static uint16_t cursor_x, cursor_y;
+static bool     window_valid;
+
+/*-----------------------------------------------------------------------------
+ *  TFT and SPI stand-ins
+ *-----------------------------------------------------------------------------*/
+
+uint16_t tft_get_width(void)
+{
+    return SCREEN_WIDTH;
+}
+
+uint16_t tft_get_height(void)
+{
+    return SCREEN_HEIGHT;
+}
+
+/**
+ * @brief   Write pixels as the panel would: a new window restarts at its
+ *          top left corner, the same window continues at the cursor
+ */
+void tft_write_pixels(uint16_t x0, uint16_t y0,
+                      uint16_t x1, uint16_t y1,
+                      const uint16_t *pixels, uint32_t count)
+{
+    if (!window_valid || (x0 != window_x0) || (y0 != window_y0) ||
+        (x1 != window_x1) || (y1 != window_y1))
+    {
+        window_x0 = x0;
+        window_y0 = y0;
+        window_x1 = x1;
+        window_y1 = y1;
+        cursor_x = x0;
+        cursor_y = y0;
+        window_valid = true;
+    }
+
+    ASSERT((x1 < SCREEN_WIDTH) && (y1 < SCREEN_HEIGHT));
+
+    while (count--)
+    {
+        ASSERT(cursor_y <= window_y1);
+
+        screen[cursor_y][cursor_x] = *pixels++;
+
+        if (++cursor_x > window_x1)
+        {
+            cursor_x = window_x0;
+            cursor_y++;
+        }
+    }
+}
+
+void spi_flush(spi_instance_t spi_instance)
+{
+    (void)spi_instance;
+}
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Encode the test image of a case with libjpeg
+ * @param   test    Case
+ * @param   size    Output: file size
+ * @return  File (malloc'd)
+ */
+static uint8_t *encode(const jpeg_case_t *test, unsigned long *size)
+{
+    struct jpeg_compress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    unsigned char *file = NULL;
+    JSAMPROW row;
+    bool grey = (test->h == 0);
+    uint16_t x, y;
+    int wave;
+
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    jpeg_mem_dest(&cinfo, &file, size);
+
+    cinfo.image_width = test->width;
+    cinfo.image_height = test->height;
+    cinfo.input_components = grey ? 1 : 3;
+    cinfo.in_color_space = grey ? JCS_GRAYSCALE : JCS_RGB;
+
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, test->quality, TRUE);
+
+    if (!grey)
+    {
+        cinfo.comp_info[0].h_samp_factor = test->h;
+        cinfo.comp_info[0].v_samp_factor = test->v;
+    }
+
+    cinfo.restart_interval = test->restart;
+    cinfo.optimize_coding = test->optimize;
+
+    if (test->progressive)
+    {
+        jpeg_simple_progression(&cinfo);
+    }
+
+    jpeg_start_compress(&cinfo, TRUE);
+
+    row = malloc(test->width * 3);
+
+    /* Gradients, a checker pattern and a wave: edges and smooth areas.
+     * The busy pattern is noise-like, with long codes and zero runs */
+    for (y = 0; y < test->height; y++)
+    {
+        for (x = 0; x < test->width; x++)
+        {
+            wave = (int)(128 + 100 * sin(x * 0.11 + y * 0.07));
+
+            if (test->busy)
+            {
+                row[3 * x] = (x * 1281 + y * 3) & 0xff;
+                row[3 * x + 1] = (int)(128 + 100 * sin(x * 54.9 + y));
+                row[3 * x + 2] = ((x ^ y) & 183) ? 220 : 30;
+            }
+            else if (grey)
+            {
+                row[x] = (wave + x * 255 / test->width) / 2;
+            }
+            else
+            {
+                row[3 * x] = x * 255 / test->width;
+                row[3 * x + 1] = (y * 255 / test->height + wave) / 2;
+                row[3 * x + 2] = ((x ^ y) & 16) ? 220 : 30;
+            }
+        }
+
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    free(row);
+
+    return file;
+}
+
+/**
+ * @brief   Decode a file into the screen model, one byte at a time
+ * @param   file    File
+ * @param   size    Bytes fed
+ * @param   x       Screen x coordinate of the top left corner
+ * @param   y       Screen y coordinate of the top left corner
+ * @param   fed     Output: every byte was accepted
+ * @return  Result of jpeg_end
+ */
+static bool decode(const uint8_t *file, uint32_t size,
+                   uint16_t x, uint16_t y, bool *fed)
+{
+    uint32_t i;
+
+    memset(screen, 0, sizeof(screen));
+    window_valid = false;
+
+    *fed = true;
+
+    jpeg_begin(x, y);
+
+    for (i = 0; i < size; i++)
+    {
+        if (!jpeg_feed(file[i]))
+        {
+            *fed = false;
+        }
+    }
+
+    return jpeg_end();
+}
+
+/**
+ * @brief   Largest channel difference between the screen and libjpeg
+ * @param   file    File
+ * @param   size    File size
+ * @param   x       Screen x coordinate of the top left corner
+ * @param   y       Screen y coordinate of the top left corner
+ * @param   rows    Image rows compared
+ * @return  Difference on the 8-bit scale
+ */
+static int compare(const uint8_t *file, unsigned long size,
+                   uint16_t x, uint16_t y, uint16_t rows)
+{
+    struct jpeg_decompress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    JSAMPROW row;
+    uint16_t pixel;
+    uint16_t col, line;
+    int r, g, b;
+    int diff = 0;
+
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, (unsigned char *)file, size);
+    jpeg_read_header(&cinfo, TRUE);
+
+    cinfo.dct_method = JDCT_ISLOW;
+    cinfo.do_fancy_upsampling = FALSE;
+    cinfo.out_color_space = JCS_RGB;
+
+    jpeg_start_decompress(&cinfo);
+
+    row = malloc(cinfo.output_width * 3);
+
+    for (line = 0; line < cinfo.output_height; line++)
+    {
+        jpeg_read_scanlines(&cinfo, &row, 1);
+
+        if ((line >= rows) || (y + line >= SCREEN_HEIGHT))
+        {
+            continue;
+        }
+
+        for (col = 0; (col < cinfo.output_width) &&
+                      (x + col < SCREEN_WIDTH); col++)
+        {
+            pixel = screen[y + line][x + col];
+
+            r = abs(((pixel >> 11) << 3) - (row[3 * col] & ~7));
+            g = abs((((pixel >> 5) & 0x3f) << 2) - (row[3 * col + 1] & ~3));
+            b = abs(((pixel & 0x1f) << 3) - (row[3 * col + 2] & ~7));
+
+            diff = max(diff, max(r, max(g, b)));
+        }
+    }
+
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    free(row);
+
+    return diff;
+}
+
+/**
+ * @brief   Write the screen model as a binary PPM file
+ * @param   path    File name
+ * @return  False if the file cannot be written
+ */
+static bool write_ppm(const char *path)
+{
+    FILE *out = fopen(path, "wb");
+    uint16_t pixel;
+    uint16_t x, y;
+
+    if (out == NULL)
+    {
+        return false;
+    }
+
+    fprintf(out, "P6\n%u %u\n255\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    for (y = 0; y < SCREEN_HEIGHT; y++)
+    {
+        for (x = 0; x < SCREEN_WIDTH; x++)
+        {
+            pixel = screen[y][x];
+
+            fputc((pixel >> 11) << 3, out);
+            fputc(((pixel >> 5) & 0x3f) << 2, out);
+            fputc((pixel & 0x1f) << 3, out);
+        }
+    }
+
+    fclose(out);
+
+    return true;
+}
+
+/**
+ * @brief   Run one case
+ * @param   test    Case
+ * @return  True if passed
+ */
+static bool run(const jpeg_case_t *test)
+{
+    unsigned long size;
+    uint8_t *file = encode(test, &size);
+    uint32_t fed_size = size;
+    char path[64];
+    bool fed;
+    bool done;
+    bool pass;
+    int diff = 0;
+    uint16_t rows = test->height;
+
+    if ((test->truncate > 0) && (test->truncate < size))
+    {
+        fed_size = test->truncate;
+    }
+
+    done = decode(file, fed_size, test->x, test->y, &fed);
+
+    if (test->progressive)
+    {
+        /* Refused, and nothing drawn */
+        pass = !done;
+    }
+    else if (fed_size < size)
+    {
+        /*
+         * Running out of input is not corruption: every byte is accepted.
+         * Only MCU rows well within the bytes fed are compared
+         */
+        rows = (test->height / 4) & ~15;
+        diff = compare(file, size, test->x, test->y, rows);
+        pass = fed && (diff <= MAX_DIFF);
+    }
+    else
+    {
+        diff = compare(file, size, test->x, test->y, rows);
+        pass = fed && done && (diff <= MAX_DIFF);
+    }
+
+    snprintf(path, sizeof(path), "%s.ppm", test->name);
+    write_ppm(path);
+
+    printf("%-14s %3ux%-3u %5lu bytes  feed %s  end %s  diff %2d  %s\n",
+           test->name, test->width, test->height, size,
+           fed ? "ok  " : "FAIL", done ? "ok  " : "FAIL", diff,
+           pass ? "pass" : "FAIL");
+
+    free(file);
+
+    return pass;
+}
+
+/*-----------------------------------------------------------------------------
+ *  Main
+ *-----------------------------------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+    static uint8_t file[1 << 20];
+    FILE *in;
+    size_t size;
+    bool fed;
+    bool done;
+    uint8_t i;
+    uint8_t failed = 0;
+
+    scratch_init();
+
+    if (argc >= 3)
+    {
+        in = fopen(argv[1], "rb");
+
+        if (in == NULL)
+        {
+            fprintf(stderr, "cannot open %s\n", argv[1]);
+            return 2;
+        }
+
+        size = fread(file, 1, sizeof(file), in);
+        fclose(in);
+
+        done = decode(file, size, (argc > 4) ? atoi(argv[3]) : 0,
+                      (argc > 4) ? atoi(argv[4]) : 0, &fed);
+
+        if (!write_ppm(argv[2]))
+        {
+            fprintf(stderr, "cannot write %s\n", argv[2]);
+            return 2;
+        }
+
+        return (fed && done) ? 0 : 1;
+    }
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        if (!run(&cases[i]))
+        {
+            failed++;
+        }
+    }
+
+    printf("%u of %u cases failed\n", failed,
+           (unsigned)(sizeof(cases) / sizeof(cases[0])));
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,391 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  raster_bench.c
+ *
+ *    Description:  Host benchmark of the filled shape rasteriser
+ *                  raster.c drives a byte-counting block output that
+ *                  prices each block the way tft.c sends it: CASET and
+ *                  PASET (5 bytes each, skipped when unchanged), RAMWR or
+ *                  RAMWRC (1 byte) and 2 bytes per pixel.
+ *
+ *                  Before: filled circles were two tft_draw_vertical_line
+ *                  windows per step, and there was no polygon fill, so a
+ *                  polygon had to be filled with one tft_draw_horizontal_line
+ *                  per row span. After: one window per merged block.
+ *
+ *                  Reports SPI bytes per filled pixel for both; fails if a
+ *                  shape costs more after than before.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 04:58:33 PM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Standard includes */
+#include <stdio.h>
+
+/* Local Includes */
+#include "raster.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* Screen size (landscape) */
+#define SCREEN_WIDTH        (320)
+#define SCREEN_HEIGHT       (240)
+
+/* Command byte plus start and end address */
+#define ADDRESS_SET_BYTES   (5U)
+
+/* RAMWR or RAMWRC */
+#define MEMORY_WRITE_BYTES  (1U)
+
+/* RGB565 */
+#define PIXEL_BYTES         (2U)
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+/* Controller window and write cursor, as tracked by tft.c */
+typedef struct
+{
+    int16_t  win_x0;
+    int16_t  win_x1;
+    int16_t  win_y0;
+    int16_t  win_y1;
+    bool     column_valid;
+    bool     page_valid;
+
+    int16_t  cursor_x;
+    int16_t  cursor_y;
+    bool     cursor_valid;
+
+    /* Bytes and windows sent */
+    uint32_t bytes;
+    uint32_t windows;
+} bus_t;
+
+/* Shape drawn by both paths */
+typedef struct
+{
+    const char           *name;
+
+    /* Circle if count is 0 */
+    int16_t              xc;
+    int16_t              yc;
+    int16_t              r;
+
+    const raster_point_t *points;
+    uint8_t              count;
+} shape_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static bus_t bus;
+
+/* Pixels covered by the shape */
+static uint8_t coverage[SCREEN_HEIGHT][SCREEN_WIDTH];
+
+static const raster_point_t triangle[] =
+{
+    { 20, 200 }, { 160, 20 }, { 300, 220 }
+};
+
+static const raster_point_t rectangle[] =
+{
+    { 40, 40 }, { 279, 40 }, { 279, 199 }, { 40, 199 }
+};
+
+static const raster_point_t hexagon[] =
+{
+    { 100, 20 }, { 220, 20 }, { 280, 120 }, { 220, 220 }, { 100, 220 }, { 40, 120 }
+};
+
+/* Even-odd: the centre pentagon is a hole */
+static const raster_point_t star[] =
+{
+    { 160, 10 }, { 225, 210 }, { 55, 85 }, { 265, 85 }, { 95, 210 }
+};
+
+static const shape_t shapes[] =
+{
+    { "circle r=4",   160, 120,   4, NULL,         0 },
+    { "circle r=16",  160, 120,  16, NULL,         0 },
+    { "circle r=60",  160, 120,  60, NULL,         0 },
+    { "circle r=119", 160, 120, 119, NULL,         0 },
+    { "triangle",       0,   0,   0, &triangle[0],  3 },
+    { "rectangle",      0,   0,   0, &rectangle[0], 4 },
+    { "hexagon",        0,   0,   0, &hexagon[0],   6 },
+    { "star",           0,   0,   0, &star[0],      5 },
+};
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Forget the programmed window, as at power up
+ */
+static void bus_reset(void)
+{
+    memset(&bus, 0, sizeof(bus));
+}
+
+/**
+ * @brief   Check whether the window continues at the write cursor
+ *          (tft.c window_continues)
+ */
+static bool bus_continues(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    bool result = false;
+
+    if (bus.column_valid && bus.page_valid && bus.cursor_valid &&
+        (bus.cursor_x == x0) && (bus.cursor_y == y0))
+    {
+        if ((y0 == y1) && (x0 <= x1) && (x1 <= bus.win_x1))
+        {
+            result = true;
+        }
+        else if ((x0 == bus.win_x0) && (x1 == bus.win_x1) &&
+                 (y0 <= y1) && (y1 <= bus.win_y1))
+        {
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief   Count one window and its pixels (tft.c set_window and
+ *          stream_color)
+ * @param   x0      Top left x coordinate
+ * @param   y0      Top left y coordinate
+ * @param   x1      Bottom right x coordinate
+ * @param   y1      Bottom right y coordinate
+ * @param   pixels  Pixels streamed
+ */
+static void bus_window(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                       uint32_t pixels)
+{
+    uint32_t width;
+    uint32_t offset;
+
+    if (!bus_continues(x0, y0, x1, y1))
+    {
+        if (!bus.column_valid || (bus.win_x0 != x0) || (bus.win_x1 != x1))
+        {
+            bus.bytes += ADDRESS_SET_BYTES;
+            bus.win_x0 = x0;
+            bus.win_x1 = x1;
+            bus.column_valid = true;
+        }
+
+        if (!bus.page_valid || (bus.win_y0 != y0) || (bus.win_y1 != y1))
+        {
+            bus.bytes += ADDRESS_SET_BYTES;
+            bus.win_y0 = y0;
+            bus.win_y1 = y1;
+            bus.page_valid = true;
+        }
+
+        bus.cursor_x = x0;
+        bus.cursor_y = y0;
+        bus.cursor_valid = true;
+    }
+
+    bus.bytes += MEMORY_WRITE_BYTES + PIXEL_BYTES * pixels;
+    bus.windows++;
+
+    width = bus.win_x1 - bus.win_x0 + 1;
+    offset = (bus.cursor_y - bus.win_y0) * width + (bus.cursor_x - bus.win_x0);
+    offset = (offset + pixels) % (width * (bus.win_y1 - bus.win_y0 + 1));
+
+    bus.cursor_x = bus.win_x0 + (offset % width);
+    bus.cursor_y = bus.win_y0 + (offset / width);
+}
+
+/**
+ * @brief   After: one window per block, clipped (tft.c write_block)
+ *          Also marks the pixels covered
+ */
+static void block_after(int16_t x0, int16_t y0,
+                        int16_t x1, int16_t y1,
+                        uint16_t color)
+{
+    int16_t x;
+    int16_t y;
+
+    (void)color;
+
+    if ((x1 < 0) || (y1 < 0) ||
+        (x0 >= SCREEN_WIDTH) || (y0 >= SCREEN_HEIGHT))
+    {
+        return;
+    }
+
+    x0 = max(x0, 0);
+    y0 = max(y0, 0);
+    x1 = min(x1, SCREEN_WIDTH - 1);
+    y1 = min(y1, SCREEN_HEIGHT - 1);
+
+    bus_window(x0, y0, x1, y1, (uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1));
+
+    for (y = y0; y <= y1; y++)
+    {
+        for (x = x0; x <= x1; x++)
+        {
+            coverage[y][x] = 1;
+        }
+    }
+}
+
+/**
+ * @brief   Before: tft_draw_horizontal_line for every row of the block
+ *          (window x to x + length, length pixels)
+ */
+static void block_rows(int16_t x0, int16_t y0,
+                       int16_t x1, int16_t y1,
+                       uint16_t color)
+{
+    int16_t y;
+
+    (void)color;
+
+    for (y = y0; y <= y1; y++)
+    {
+        bus_window(x0, y, x1 + 1, y, x1 - x0 + 1);
+    }
+}
+
+/**
+ * @brief   Before: tft_fill_circle as it was, two tft_draw_vertical_line
+ *          (window y to y + length, length pixels) per step
+ */
+static void old_fill_circle(int16_t xc, int16_t yc, int16_t r)
+{
+    int16_t x = -r;
+    int16_t y = 0;
+    int16_t err = 2 - 2 * r;
+    int16_t e2;
+
+    do
+    {
+        bus_window(xc - x, yc - y, xc - x, yc + y, 2 * y);
+        bus_window(xc + x, yc - y, xc + x, yc + y, 2 * y);
+
+        e2 = err;
+        if (e2 <= y)
+        {
+            err += ++y * 2 + 1;
+            if (-x == y && e2 <= x)
+                e2 = 0;
+        }
+        if (e2 > x)
+            err += ++x * 2 + 1;
+    } while (x <= 0);
+}
+
+/**
+ * @brief   Pixels covered by the last shape
+ */
+static uint32_t covered(void)
+{
+    uint32_t count = 0;
+    uint32_t x;
+    uint32_t y;
+
+    for (y = 0; y < SCREEN_HEIGHT; y++)
+    {
+        for (x = 0; x < SCREEN_WIDTH; x++)
+        {
+            count += coverage[y][x];
+        }
+    }
+
+    return count;
+}
+
+/*-----------------------------------------------------------------------------
+ *  Main
+ *-----------------------------------------------------------------------------*/
+
+int main(void)
+{
+    const shape_t *shape;
+    uint32_t before_bytes;
+    uint32_t before_windows;
+    uint32_t pixels;
+    uint8_t  failed = 0;
+    uint32_t i;
+    bool     pass;
+
+    printf("%-13s %6s  %19s  %19s  %s\n", "", "",
+           "before", "after", "");
+    printf("%-13s %6s  %8s %5s %4s  %8s %5s %4s\n", "shape", "pixels",
+           "bytes", "win", "B/px", "bytes", "win", "B/px");
+
+    for (i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++)
+    {
+        shape = &shapes[i];
+
+        bus_reset();
+
+        if (shape->count == 0)
+        {
+            old_fill_circle(shape->xc, shape->yc, shape->r);
+        }
+        else
+        {
+            raster_fill_polygon(block_rows, shape->points, shape->count, 0);
+        }
+
+        before_bytes = bus.bytes;
+        before_windows = bus.windows;
+
+        bus_reset();
+        memset(coverage, 0, sizeof(coverage));
+
+        if (shape->count == 0)
+        {
+            raster_fill_circle(block_after, shape->xc, shape->yc, shape->r, 0);
+        }
+        else
+        {
+            raster_fill_polygon(block_after, shape->points, shape->count, 0);
+        }
+
+        pixels = covered();
+        pass = (bus.bytes <= before_bytes);
+
+        printf("%-13s %6u  %8u %5u %4.2f  %8u %5u %4.2f  %s\n",
+               shape->name, pixels,
+               before_bytes, before_windows, (double)before_bytes / pixels,
+               bus.bytes, bus.windows, (double)bus.bytes / pixels,
+               pass ? "" : "FAIL");
+
+        if (!pass)
+        {
+            failed++;
+        }
+    }
+
+    printf("%u of %u shapes cost more after\n", failed,
+           (unsigned)(sizeof(shapes) / sizeof(shapes[0])));
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,12 @@
+/*
+ * Host build stand-in for the StellarisWare header of the same name
+ */
+
+#ifndef DEBUG_H
+#define DEBUG_H
+
+#include <assert.h>
+
+#define ASSERT(expr)    assert(expr)
+
+#endif
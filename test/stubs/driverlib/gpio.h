@@ -0,0 +1,13 @@
+/*
+ * Host build stand-in for the StellarisWare header of the same name
+ */
+
+#ifndef GPIO_H
+#define GPIO_H
+
+#define GPIO_PIN_2              0x00000004
+#define GPIO_PIN_3              0x00000008
+
+extern void GPIOPinTypeGPIOOutput(unsigned long ulPort, unsigned char ucPins);
+
+#endif
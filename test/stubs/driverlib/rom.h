@@ -0,0 +1,11 @@
+/*
+ * Host build stand-in for the StellarisWare header of the same name
+ */
+
+#ifndef ROM_H
+#define ROM_H
+
+extern void ROM_GPIOPinWrite(unsigned long ulPort, unsigned char ucPins,
+                             unsigned char ucVal);
+
+#endif
@@ -0,0 +1,13 @@
+/*
+ * Host build stand-in for the StellarisWare header of the same name
+ */
+
+#ifndef SYSCTL_H
+#define SYSCTL_H
+
+#define SYSCTL_PERIPH_GPIOA     0x20000001
+#define SYSCTL_PERIPH_GPIOE     0x20000010
+
+extern void SysCtlPeripheralEnable(unsigned long ulPeripheral);
+
+#endif
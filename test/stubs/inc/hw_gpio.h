@@ -0,0 +1,8 @@
+/*
+ * Host build stand-in for the StellarisWare header of the same name
+ */
+
+#ifndef HW_GPIO_H
+#define HW_GPIO_H
+
+#endif
@@ -0,0 +1,8 @@
+/*
+ * Host build stand-in for the StellarisWare header of the same name
+ */
+
+#ifndef HW_INTS_H
+#define HW_INTS_H
+
+#endif
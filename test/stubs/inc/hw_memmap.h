@@ -0,0 +1,11 @@
+/*
+ * Host build stand-in for the StellarisWare header of the same name
+ */
+
+#ifndef HW_MEMMAP_H
+#define HW_MEMMAP_H
+
+#define GPIO_PORTA_BASE         0x40004000
+#define GPIO_PORTE_BASE         0x40024000
+
+#endif
@@ -0,0 +1,10 @@
+/*
+ * Host build stand-in for the StellarisWare header of the same name
+ */
+
+#ifndef HW_NVIC_H
+#define HW_NVIC_H
+
+#define NVIC_ST_CURRENT 0xE000E018
+
+#endif
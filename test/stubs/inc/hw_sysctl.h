@@ -0,0 +1,8 @@
+/*
+ * Host build stand-in for the StellarisWare header of the same name
+ */
+
+#ifndef HW_SYSCTL_H
+#define HW_SYSCTL_H
+
+#endif
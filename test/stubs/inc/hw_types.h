@@ -0,0 +1,15 @@
+/*
+ * Host build stand-in for the StellarisWare header of the same name
+ */
+
+#ifndef HW_TYPES_H
+#define HW_TYPES_H
+
+#include <stdint.h>
+
+typedef unsigned char tBoolean;
+
+/* Register access has no target on the host */
+#define HWREG(x)        (*((volatile unsigned long *)(uintptr_t)(x)))
+
+#endif
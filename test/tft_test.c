@@ -0,0 +1,749 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  tft_test.c
+ *
+ *    Description:  Host test of the TFT byte stream
+ *                  tft.c is built against a recording SPI stand-in which
+ *                  keeps every byte shifted out on the bus with its D/C
+ *                  level (a 16-bit frame goes out MSB first, as two bytes).
+ *                  Each case is also written by the 8-bit writer tft.c had
+ *                  before pixels were sent as 16-bit frames: one spi_write
+ *                  per byte, CASET/PASET/RAMWR before every area, glyphs
+ *                  drawn as 64 filled cells.
+ *
+ *                  Fill and image streams must match the old stream byte
+ *                  for byte. A glyph is now one window, so both streams
+ *                  are played into a panel model and the screens compared.
+ *
+ *        Version:  1.0
+ *        Created:  10/17/2026 07:36:22 AM
+ *       Revision:  none
+ *       Compiler:  gcc
+ *
+ *         Author:  Low Jeng Lam (jeng), jenglamlow@gmail.com
+ *   Organization:  Malaysia
+ *
+ * =====================================================================================
+ */
+
+/*-----------------------------------------------------------------------------
+ *  Includes
+ *-----------------------------------------------------------------------------*/
+/* Standard includes */
+#include <stdio.h>
+
+/* Local Includes */
+#include "tft.h"
+#include "fonts.h"
+#include "scratch.h"
+
+/*-----------------------------------------------------------------------------
+ *  Configurations
+ *-----------------------------------------------------------------------------*/
+
+/* Screen size (landscape) */
+#define SCREEN_WIDTH        (320U)
+#define SCREEN_HEIGHT       (240U)
+
+/* Bytes recorded per stream (a full screen fill is 153611) */
+#define WIRE_SIZE           (1UL << 19)
+
+/* D/C level of a recorded byte */
+#define WIRE_DC             (0x100U)
+
+/* ILI9341 commands decoded by the panel model */
+#define CASET               (0x2A)
+#define PASET               (0x2B)
+#define RAMWR               (0x2C)
+#define RAMWRC              (0x3C)
+
+/*-----------------------------------------------------------------------------
+ *  Private Types
+ *-----------------------------------------------------------------------------*/
+
+/* Bytes shifted out on the bus */
+typedef struct
+{
+    /* Byte, WIRE_DC set in the data phase */
+    uint16_t entry[WIRE_SIZE];
+    uint32_t count;
+
+    /* SSI frames written (one per byte with 8-bit frames) */
+    uint32_t frames;
+} wire_t;
+
+/* Test case */
+typedef struct
+{
+    const char *name;
+
+    /* Draw with tft.c, and with the old 8-bit writer */
+    void      (*draw)(void);
+    void      (*draw_old)(void);
+
+    /* Streams must match byte for byte, else only the screens */
+    bool        same_bytes;
+} tft_case_t;
+
+/*-----------------------------------------------------------------------------
+ *  Private Data
+ *-----------------------------------------------------------------------------*/
+
+static wire_t   wire_new;
+static wire_t   wire_old;
+
+/* Panel models */
+static uint16_t screen_new[SCREEN_HEIGHT][SCREEN_WIDTH];
+static uint16_t screen_old[SCREEN_HEIGHT][SCREEN_WIDTH];
+
+/* Pins and frame size seen by the SPI stand-in */
+static bool     dc_pin;
+static bool     cs_pin = true;
+static uint8_t  frame_width = SPI_DATA_WIDTH_8;
+
+/* Image pixels */
+static uint16_t image[2][128];
+
+/*-----------------------------------------------------------------------------
+ *  GPIO and SPI stand-ins
+ *-----------------------------------------------------------------------------*/
+
+void SysCtlPeripheralEnable(unsigned long ulPeripheral)
+{
+    (void)ulPeripheral;
+}
+
+void GPIOPinTypeGPIOOutput(unsigned long ulPort, unsigned char ucPins)
+{
+    (void)ulPort;
+    (void)ucPins;
+}
+
+/**
+ * @brief   D/C is PE2, CS is PA3 (see tft.c)
+ */
+void ROM_GPIOPinWrite(unsigned long ulPort, unsigned char ucPins,
+                      unsigned char ucVal)
+{
+    if ((ulPort == GPIO_PORTE_BASE) && (ucPins & GPIO_PIN_2))
+    {
+        dc_pin = (ucVal & GPIO_PIN_2) != 0;
+    }
+
+    if ((ulPort == GPIO_PORTA_BASE) && (ucPins & GPIO_PIN_3))
+    {
+        cs_pin = (ucVal & GPIO_PIN_3) != 0;
+    }
+}
+
+/**
+ * @brief   Record one byte on the bus
+ * @param   wire    Stream
+ * @param   byte    Byte
+ * @param   dc      D/C level
+ */
+static void wire_put(wire_t *wire, uint8_t byte, bool dc)
+{
+    ASSERT(wire->count < WIRE_SIZE);
+
+    wire->entry[wire->count++] = byte | (dc ? WIRE_DC : 0);
+}
+
+/**
+ * @brief   Shift out one frame of the configured width, MSB first
+ * @param   frame   Frame
+ */
+static void put_frame(uint16_t frame)
+{
+    /* Every frame is sent with the panel selected */
+    ASSERT(!cs_pin);
+
+    if (frame_width == SPI_DATA_WIDTH_16)
+    {
+        wire_put(&wire_new, frame >> 8, dc_pin);
+    }
+    else
+    {
+        ASSERT(frame <= 0xff);
+    }
+
+    wire_put(&wire_new, frame & 0xff, dc_pin);
+    wire_new.frames++;
+}
+
+void spi_open(spi_instance_t spi_instance, spi_tx_cb_t spi_tx_cb)
+{
+    (void)spi_instance;
+    (void)spi_tx_cb;
+}
+
+void spi_write(spi_instance_t spi_instance, uint8_t data)
+{
+    (void)spi_instance;
+
+    put_frame(data);
+}
+
+void spi_write_word(spi_instance_t spi_instance, uint16_t data)
+{
+    (void)spi_instance;
+    ASSERT(frame_width == SPI_DATA_WIDTH_16);
+
+    put_frame(data);
+}
+
+void spi_write_burst(spi_instance_t spi_instance,
+                     const uint8_t *data, uint32_t size)
+{
+    uint32_t i;
+
+    (void)spi_instance;
+
+    if (frame_width == SPI_DATA_WIDTH_16)
+    {
+        ASSERT((size % 2) == 0);
+
+        for (i = 0; i < size; i += 2)
+        {
+            put_frame(convert_to_word(data[i], data[i + 1]));
+        }
+    }
+    else
+    {
+        for (i = 0; i < size; i++)
+        {
+            put_frame(data[i]);
+        }
+    }
+}
+
+void spi_write_words(spi_instance_t spi_instance,
+                     const uint16_t *data, uint32_t count)
+{
+    (void)spi_instance;
+    ASSERT(frame_width == SPI_DATA_WIDTH_16);
+
+    while (count--)
+    {
+        put_frame(*data++);
+    }
+}
+
+void spi_write_repeat(spi_instance_t spi_instance,
+                      uint16_t pattern, uint32_t count)
+{
+    (void)spi_instance;
+
+    while (count--)
+    {
+        put_frame(pattern);
+    }
+}
+
+/**
+ * @brief   uDMA stand-in, the transfer completes at once
+ */
+void spi_write_dma(spi_instance_t spi_instance, const void *src,
+                   uint32_t count, bool src_increment)
+{
+    const uint8_t *bytes = src;
+    const uint16_t *words = src;
+
+    (void)spi_instance;
+    ASSERT(count > 0);
+
+    while (count--)
+    {
+        if (frame_width == SPI_DATA_WIDTH_16)
+        {
+            put_frame(*words);
+            words += src_increment ? 1 : 0;
+        }
+        else
+        {
+            put_frame(*bytes);
+            bytes += src_increment ? 1 : 0;
+        }
+    }
+}
+
+void spi_flush(spi_instance_t spi_instance)
+{
+    (void)spi_instance;
+}
+
+bool spi_busy(spi_instance_t spi_instance)
+{
+    (void)spi_instance;
+
+    return false;
+}
+
+void spi_set_data_width(spi_instance_t spi_instance, uint8_t data_width)
+{
+    (void)spi_instance;
+
+    frame_width = data_width;
+}
+
+/*-----------------------------------------------------------------------------
+ *  Old 8-bit writer
+ *-----------------------------------------------------------------------------*/
+
+static void old_command(uint8_t cmd)
+{
+    wire_put(&wire_old, cmd, false);
+    wire_old.frames++;
+}
+
+static void old_data(uint8_t data)
+{
+    wire_put(&wire_old, data, true);
+    wire_old.frames++;
+}
+
+static void old_word(uint16_t word)
+{
+    old_data(word >> 8);
+    old_data(word & 0xff);
+}
+
+static void old_set_area(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    old_command(CASET);
+    old_word(x0);
+    old_word(x1);
+    old_command(PASET);
+    old_word(y0);
+    old_word(y1);
+    old_command(RAMWR);
+}
+
+static void old_fill_area(uint16_t x0, uint16_t y0,
+                          uint16_t x1, uint16_t y1, uint16_t color)
+{
+    uint16_t swap;
+    uint32_t xy;
+
+    if (x0 > x1)
+    {
+        swap = x0;
+        x0 = x1;
+        x1 = swap;
+    }
+
+    if (y0 > y1)
+    {
+        swap = y0;
+        y0 = y1;
+        y1 = swap;
+    }
+
+    x0 = constrain(x0, 0, SCREEN_WIDTH - 1);
+    x1 = constrain(x1, 0, SCREEN_WIDTH - 1);
+    y0 = constrain(y0, 0, SCREEN_HEIGHT - 1);
+    y1 = constrain(y1, 0, SCREEN_HEIGHT - 1);
+
+    old_set_area(x0, y0, x1, y1);
+
+    for (xy = (uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1); xy > 0; xy--)
+    {
+        old_word(color);
+    }
+}
+
+static void old_draw_char(uint8_t ascii, uint16_t x, uint16_t y,
+                          uint16_t size, uint16_t fgcolor, uint16_t bgcolor)
+{
+    uint8_t i, f;
+
+    for (i = 0; i < TFT_FONT_X; i++)
+    {
+        for (f = 0; f < 8; f++)
+        {
+            /* tft_fill_rectangle: (size + 1) square cells */
+            old_fill_area(x + i * size, y + f * size,
+                          x + i * size + size, y + f * size + size,
+                          ((font_map[ascii - 0x20][i] >> f) & 0x01) ?
+                          fgcolor : bgcolor);
+        }
+    }
+}
+
+static void old_image(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+                      const uint16_t *pixels, uint32_t count)
+{
+    old_set_area(x0, y0, x1, y1);
+
+    while (count--)
+    {
+        old_word(*pixels++);
+    }
+}
+
+/*-----------------------------------------------------------------------------
+ *  Test cases
+ *-----------------------------------------------------------------------------*/
+
+/* Fewer pixels than DMA_MIN_PIXELS go through the FIFO */
+static void fill_small(void)
+{
+    tft_fill_area(10, 20, 13, 25, RED);
+}
+
+static void fill_small_old(void)
+{
+    old_fill_area(10, 20, 13, 25, RED);
+}
+
+static void fill_dma(void)
+{
+    tft_fill_area(0, 0, 99, 49, 0x1234);
+}
+
+static void fill_dma_old(void)
+{
+    old_fill_area(0, 0, 99, 49, 0x1234);
+}
+
+static void fill_swapped(void)
+{
+    tft_fill_area(350, 40, 300, 4, GREEN);
+}
+
+static void fill_swapped_old(void)
+{
+    old_fill_area(350, 40, 300, 4, GREEN);
+}
+
+static void fill_screen(void)
+{
+    tft_clear_screen();
+}
+
+static void fill_screen_old(void)
+{
+    old_fill_area(0, 0, SCREEN_WIDTH - 1, SCREEN_HEIGHT - 1, BLACK);
+}
+
+/* Image bytes one at a time, as the IMG command sends them */
+static void image_bytes(void)
+{
+    uint16_t i;
+
+    tft_start_image_transfer(30, 40, 39, 44);
+
+    for (i = 0; i < 50; i++)
+    {
+        tft_send_data_only(image[0][i] >> 8);
+        tft_send_data_only(image[0][i] & 0xff);
+    }
+
+    tft_done_transfer();
+}
+
+static void image_bytes_old(void)
+{
+    old_image(30, 40, 39, 44, &image[0][0], 50);
+}
+
+/* Odd byte count: the last byte goes out as an 8-bit frame */
+static void image_odd(void)
+{
+    uint16_t i;
+
+    tft_start_image_transfer(200, 200, 203, 200);
+
+    for (i = 0; i < 3; i++)
+    {
+        tft_send_data_only(image[0][i] >> 8);
+        tft_send_data_only(image[0][i] & 0xff);
+    }
+
+    tft_send_data_only(image[0][3] >> 8);
+
+    tft_done_transfer();
+}
+
+static void image_odd_old(void)
+{
+    old_image(200, 200, 203, 200, &image[0][0], 3);
+    old_data(image[0][3] >> 8);
+}
+
+/* Image blocks in ping-pong buffers */
+static void image_pixels(void)
+{
+    tft_start_image_transfer(64, 10, 127, 13);
+    tft_send_pixels(&image[0][0], 128);
+    tft_send_pixels(&image[1][0], 128);
+    tft_done_transfer();
+}
+
+static void image_pixels_old(void)
+{
+    uint16_t i;
+
+    old_image(64, 10, 127, 13, &image[0][0], 128);
+
+    for (i = 0; i < 128; i++)
+    {
+        old_word(image[1][i]);
+    }
+}
+
+static void write_pixels(void)
+{
+    tft_write_pixels(100, 100, 115, 107, &image[1][0], 128);
+}
+
+static void write_pixels_old(void)
+{
+    old_image(100, 100, 115, 107, &image[1][0], 128);
+}
+
+/* Glyphs: cached sizes, the largest cached size and an expanded one */
+static void glyph_1(void)
+{
+    tft_draw_char('A', 0, 0, 1, WHITE, BLUE);
+}
+
+static void glyph_1_old(void)
+{
+    old_draw_char('A', 0, 0, 1, WHITE, BLUE);
+}
+
+static void glyph_3(void)
+{
+    tft_draw_char('g', 17, 33, 3, YELLOW, GRAY2);
+}
+
+static void glyph_3_old(void)
+{
+    old_draw_char('g', 17, 33, 3, YELLOW, GRAY2);
+}
+
+static void glyph_6(void)
+{
+    tft_draw_char('#', 250, 150, 6, CYAN, BLACK);
+}
+
+static void glyph_6_old(void)
+{
+    old_draw_char('#', 250, 150, 6, CYAN, BLACK);
+}
+
+static void glyph_7(void)
+{
+    tft_draw_char('W', 40, 60, 7, BRIGHT_RED, WHITE);
+}
+
+static void glyph_7_old(void)
+{
+    old_draw_char('W', 40, 60, 7, BRIGHT_RED, WHITE);
+}
+
+/* The same glyph twice, then another colour in the same place: a cache
+ * hit, memory write continue, and a miss */
+static void glyph_again(void)
+{
+    tft_draw_char('x', 5, 5, 2, GREEN, BLACK);
+    tft_draw_char('x', 5, 5, 2, GREEN, BLACK);
+    tft_draw_char('x', 5, 5, 2, BLACK, GREEN);
+}
+
+static void glyph_again_old(void)
+{
+    old_draw_char('x', 5, 5, 2, GREEN, BLACK);
+    old_draw_char('x', 5, 5, 2, GREEN, BLACK);
+    old_draw_char('x', 5, 5, 2, BLACK, GREEN);
+}
+
+static const tft_case_t cases[] =
+{
+    /* name            draw           draw_old           same_bytes */
+    { "fill_small",    fill_small,    fill_small_old,    true  },
+    { "fill_dma",      fill_dma,      fill_dma_old,      true  },
+    { "fill_swapped",  fill_swapped,  fill_swapped_old,  true  },
+    { "fill_screen",   fill_screen,   fill_screen_old,   true  },
+    { "image_bytes",   image_bytes,   image_bytes_old,   true  },
+    { "image_odd",     image_odd,     image_odd_old,     true  },
+    { "image_pixels",  image_pixels,  image_pixels_old,  true  },
+    { "write_pixels",  write_pixels,  write_pixels_old,  true  },
+    { "glyph_1",       glyph_1,       glyph_1_old,       false },
+    { "glyph_3",       glyph_3,       glyph_3_old,       false },
+    { "glyph_6",       glyph_6,       glyph_6_old,       false },
+    { "glyph_7",       glyph_7,       glyph_7_old,       false },
+    { "glyph_again",   glyph_again,   glyph_again_old,   false },
+};
+
+/*-----------------------------------------------------------------------------
+ *  Helper Functions
+ *-----------------------------------------------------------------------------*/
+
+/**
+ * @brief   Play a stream into a panel model
+ *          RAMWR starts at the top left corner of the window, RAMWRC
+ *          continues at the cursor, both wrap at the end of the window
+ * @param   wire    Stream
+ * @param   screen  Panel model
+ */
+static void play(const wire_t *wire,
+                 uint16_t screen[SCREEN_HEIGHT][SCREEN_WIDTH])
+{
+    uint16_t x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    uint16_t x = 0, y = 0;
+    uint8_t  param[4];
+    uint8_t  cmd = 0;
+    uint32_t index = 0;
+    uint32_t i;
+    uint8_t  byte;
+
+    for (i = 0; i < wire->count; i++)
+    {
+        byte = wire->entry[i] & 0xff;
+
+        if (!(wire->entry[i] & WIRE_DC))
+        {
+            cmd = byte;
+            index = 0;
+
+            if (cmd == RAMWR)
+            {
+                x = x0;
+                y = y0;
+            }
+
+            continue;
+        }
+
+        if ((cmd == CASET) || (cmd == PASET))
+        {
+            if (index < 4)
+            {
+                param[index] = byte;
+            }
+
+            if (++index == 4)
+            {
+                if (cmd == CASET)
+                {
+                    x0 = convert_to_word(param[0], param[1]);
+                    x1 = convert_to_word(param[2], param[3]);
+                }
+                else
+                {
+                    y0 = convert_to_word(param[0], param[1]);
+                    y1 = convert_to_word(param[2], param[3]);
+                }
+            }
+        }
+        else if ((cmd == RAMWR) || (cmd == RAMWRC))
+        {
+            /* High byte waits for its low byte */
+            if ((index++ & 1) == 0)
+            {
+                param[0] = byte;
+                continue;
+            }
+
+            ASSERT((x < SCREEN_WIDTH) && (y < SCREEN_HEIGHT));
+
+            screen[y][x] = convert_to_word(param[0], byte);
+
+            if (++x > x1)
+            {
+                x = x0;
+
+                if (++y > y1)
+                {
+                    y = y0;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief   Run one case
+ * @param   test    Case
+ * @return  True if passed
+ */
+static bool run(const tft_case_t *test)
+{
+    bool same_bytes;
+    bool same_screen;
+    bool pass;
+
+    /* Window cache and glyph cache start empty, as after reset */
+    tft_init();
+
+    wire_new.count = 0;
+    wire_new.frames = 0;
+    wire_old.count = 0;
+    wire_old.frames = 0;
+
+    test->draw();
+    test->draw_old();
+
+    /* CS is released, frames are back to 8 bits */
+    ASSERT(cs_pin && (frame_width == SPI_DATA_WIDTH_8));
+
+    memset(screen_new, 0, sizeof(screen_new));
+    memset(screen_old, 0, sizeof(screen_old));
+
+    play(&wire_new, screen_new);
+    play(&wire_old, screen_old);
+
+    same_bytes = (wire_new.count == wire_old.count) &&
+                 (memcmp(wire_new.entry, wire_old.entry,
+                         wire_new.count * sizeof(wire_new.entry[0])) == 0);
+    same_screen = (memcmp(screen_new, screen_old, sizeof(screen_new)) == 0);
+
+    pass = same_screen && (same_bytes || !test->same_bytes);
+
+    printf("%-14s old %6u bytes %6u frames  new %6u bytes %6u frames  "
+           "bytes %s  screen %s  %s\n",
+           test->name, wire_old.count, wire_old.frames,
+           wire_new.count, wire_new.frames,
+           same_bytes ? "same" : "diff", same_screen ? "same" : "diff",
+           pass ? "pass" : "FAIL");
+
+    return pass;
+}
+
+/*-----------------------------------------------------------------------------
+ *  Main
+ *-----------------------------------------------------------------------------*/
+
+int main(void)
+{
+    uint8_t failed = 0;
+    uint16_t i;
+
+    for (i = 0; i < 128; i++)
+    {
+        image[0][i] = (uint16_t)(i * 0x0841 + 0x0100);
+        image[1][i] = (uint16_t)~(i * 0x1003);
+    }
+
+    scratch_init();
+    tft_init();
+
+    /* Landscape, as the panel model */
+    tft_set_orientation(ORIENT_H);
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        if (!run(&cases[i]))
+        {
+            failed++;
+        }
+    }
+
+    printf("%u of %u cases failed\n", failed,
+           (unsigned)(sizeof(cases) / sizeof(cases[0])));
+
+    return (failed == 0) ? 0 : 1;
+}